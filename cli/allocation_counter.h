@@ -0,0 +1,10 @@
+#ifndef CHECKERS_ALLOCATION_COUNTER_H
+#define CHECKERS_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+// Number of global operator new calls made so far by the program. Linking
+// allocation_counter.cpp replaces operator new/delete with counting versions.
+uint64_t allocationCount();
+
+#endif // CHECKERS_ALLOCATION_COUNTER_H
@@ -0,0 +1,330 @@
+// Search benchmark: searches a fixed suite of positions to a fixed depth, reports the
+// total node count as a signature of the search's behaviour, nodes per second and
+// time to depth, writes the results as JSON and compares them with a baseline run.
+
+#include "board.h"
+#include "search.h"
+#include "transposition_table.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+const int DEFAULT_BENCH_DEPTH = 13;
+const int DEFAULT_BENCH_RUNS = 3;
+const double DEFAULT_REGRESSION_PERCENT = 5.0;
+
+struct BenchPosition {
+    const char* category;
+    const char* fen;
+};
+
+// The benchmark suite: openings, middlegames, endgames and positions with multi-jumps
+// to play, mostly from fixed-seed self-play. Changing it changes the signature, so
+// baselines must be saved again afterwards.
+static const vector<BenchPosition> BENCH_SUITE = {
+    { "opening", START_FEN },
+    { "opening", "W:W19,21,22,23,24,25,26,27,28,29,30,31:B1,2,4,5,6,7,8,9,10,11,12,16" },
+    { "opening", "B:W13,18,21,23,24,26,27,28,29,30,31,32:B1,2,3,4,5,6,7,9,10,11,12,20" },
+    { "opening", "W:W17,18,20,23,25,26,27,28,29,30,31,32:B1,2,3,4,5,6,8,10,11,12,13,16" },
+    { "opening", "W:W20,21,22,23,25,26,27,29,30,31,32:B1,2,3,4,5,7,8,9,10,11,12,24" },
+    { "opening", "B:W20,21,22,25,26,27,28,29,30,31,32:B1,2,3,4,5,6,7,9,10,12,15" },
+    { "opening", "W:W19,21,23,24,25,26,28,29,30,31,32:B1,3,4,5,6,8,9,10,11,12,14" },
+    { "opening", "B:W14,24,25,26,27,28,29,30,31,32:B1,2,3,4,5,6,7,8,11,16" },
+    { "opening", "B:W19,21,22,25,26,27,29,30,31,32:B1,2,3,4,5,6,7,9,10,12" },
+    { "opening", "W:W20,21,24,25,26,28,29,30,31,32:B1,2,3,4,5,6,7,8,12,18" },
+    { "middlegame", "B:W17,21,22,26,29,31:B5,6,9,10,13,K24" },
+    { "middlegame", "B:W13,17,19,20,21,30:B2,4,5,10,12,23" },
+    { "middlegame", "B:W18,19,20,23,29,30:B4,10,11,12,13,14" },
+    { "middlegame", "B:W19,22,23,27,28,31,32:B4,5,8,10,12,13,16" },
+    { "middlegame", "W:W13,19,20,23,25,28,29,30:B1,4,5,6,8,11,12,14" },
+    { "middlegame", "W:W19,20,23,24,29,32:B2,3,4,10,12,14" },
+    { "middlegame", "W:W17,20,21,23,29,31:B3,4,6,11,15,22" },
+    { "middlegame", "B:W5,18,19,21,23,25,29,32:B1,2,4,10,12,13,16,27" },
+    { "middlegame", "B:W19,22,23,24,25,28,31,32:B1,3,4,6,10,12,14,15" },
+    { "middlegame", "B:W12,18,21,22,23,28,29,31,32:B2,3,4,5,6,8,9,10,13" },
+    { "middlegame", "B:WK2,21,22,24,27,29,32:B1,3,4,9,12,15,K30" },
+    { "endgame", "W:WK6,19,21:B4,14,25,K29" },
+    { "endgame", "W:WK2,14,21:B13,15,26,K30" },
+    { "endgame", "B:WK1,K2,32:B4,K29,K30" },
+    { "endgame", "W:WK2,K3,K4,5,29:B1,K9,18" },
+    { "endgame", "B:WK14,K18,29:BK23,26,K27,K30" },
+    { "endgame", "B:WK2,K7,K10,K22:BK14,K19" },
+    { "endgame", "B:WK1,K2,K3,K10,14:B4,K22" },
+    { "endgame", "B:WK10,K11,K18,K23:BK13,K32" },
+    { "endgame", "B:WK10,K11:B5,22,K23,K31,K32" },
+    { "endgame", "B:WK10:BK22,K26,K31,K32" },
+    { "multi-jump", "W:WK18,K22,25,30:BK7,10,14,15" },
+    { "multi-jump", "B:W11,13,15,19,20,24:B3,4,6,12,22,K23" },
+    { "multi-jump", "W:WK3,K5,24:B9,12,18,K22,K26" },
+    { "multi-jump", "W:W21,26,27,29,31:B1,4,5,7,14,19,22" },
+    { "multi-jump", "W:W24,26,28,29,30:B2,4,8,9,10,18,19" },
+    { "multi-jump", "W:WK11,20,21,31,32:B1,10,14,17,26,K29" },
+    { "multi-jump", "B:W10,18,21,22,24,25,26,28,29,30,31,32:B1,2,3,4,5,7,8,9,11,12,13" },
+    { "multi-jump", "B:W15,21,23,24,25,27,28,29,30,31,32:B1,2,3,4,5,6,7,9,10,12" },
+    { "multi-jump", "B:W9,17,20,21,24,25,29,30,31,32:B1,2,3,4,5,6,7,11,12" },
+};
+
+struct PositionResult {
+    string name; // Category and number within it, e.g. "endgame 3"
+    const char* fen;
+    string bestMove;
+    int score;
+    uint64_t nodes;
+    double seconds; // Time to depth, the fastest of the runs
+};
+
+struct BenchResult {
+    int depth;
+    size_t hashMB;
+    int runs;
+    uint64_t nodes = 0; // The signature
+    double seconds = 0.0;
+    bool deterministic = true; // Every run of a position searched the same nodes
+    vector<PositionResult> positions;
+};
+
+static void printUsage(const char* program) {
+    printf("Usage: %s [options]\n"
+           "  --depth <plies>      Search depth for every position (default %d)\n"
+           "  --runs <count>       Search every position this many times and keep the fastest (default %d)\n"
+           "  --hash <MB>          Transposition table size in megabytes (default %zu)\n"
+           "  --json <file>        Write the results as JSON, e.g. as the baseline for later runs\n"
+           "  --baseline <file>    Compare with the results a previous run wrote with --json\n"
+           "  --threshold <pct>    Fail if the time to depth is this many percent above the baseline (default %.0f)\n"
+           "  --help               Show this help\n",
+           program, DEFAULT_BENCH_DEPTH, DEFAULT_BENCH_RUNS, DEFAULT_HASH_MB, DEFAULT_REGRESSION_PERCENT);
+}
+
+// Search every suite position from an empty table, single-threaded so the node counts are reproducible
+static bool runSuite(BenchResult& bench) {
+    map<string, int> categoryCounts;
+    printf("%-14s %12s %10s %12s  %-8s %6s\n", "position", "nodes", "seconds", "nps", "best", "score");
+    for (const BenchPosition& position : BENCH_SUITE) {
+        Bitboard board;
+        char sideToMove;
+        if (!parseFen(position.fen, board, sideToMove)) {
+            fprintf(stderr, "invalid suite FEN '%s'\n", position.fen);
+            return false;
+        }
+        PositionResult entry;
+        entry.name = string(position.category) + " " + to_string(++categoryCounts[position.category]);
+        entry.fen = position.fen;
+        for (int run = 0; run < bench.runs; ++run) {
+            transpositionTable.clear();
+            SearchOptions options;
+            options.maxDepth = bench.depth;
+            options.useBook = false;
+            SearchResult result = findBestMove(board, sideToMove, options);
+            if (run > 0 && result.nodes != entry.nodes) bench.deterministic = false;
+            if (run == 0 || result.seconds < entry.seconds) entry.seconds = result.seconds;
+            entry.nodes = result.nodes;
+            entry.score = result.score;
+            entry.bestMove = result.hasMove ? moveToString(result.bestMove) : "none";
+        }
+        printf("%-14s %12llu %10.3f %12.0f  %-8s %6d\n", entry.name.c_str(), (unsigned long long)entry.nodes,
+               entry.seconds, entry.nodes / max(entry.seconds, 1e-9), entry.bestMove.c_str(), entry.score);
+        fflush(stdout);
+        bench.nodes += entry.nodes;
+        bench.seconds += entry.seconds;
+        bench.positions.push_back(entry);
+    }
+    printf("%zu positions at depth %d: signature %llu, %.3f s to depth, %.0f nodes/s\n", bench.positions.size(),
+           bench.depth, (unsigned long long)bench.nodes, bench.seconds, bench.nodes / max(bench.seconds, 1e-9));
+    if (!bench.deterministic) printf("NODE COUNTS DIFFER BETWEEN RUNS\n");
+    return true;
+}
+
+static string benchJson(const BenchResult& bench) {
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer),
+             "{\"depth\":%d,\"hashMB\":%zu,\"runs\":%d,\"signature\":%llu,\"seconds\":%.6f,\"nps\":%.0f,\"positions\":[",
+             bench.depth, bench.hashMB, bench.runs, (unsigned long long)bench.nodes, bench.seconds,
+             bench.nodes / max(bench.seconds, 1e-9));
+    string json = buffer;
+    for (size_t i = 0; i < bench.positions.size(); ++i) {
+        const PositionResult& entry = bench.positions[i];
+        snprintf(buffer, sizeof(buffer),
+                 "%s\n{\"name\":\"%s\",\"fen\":\"%s\",\"bestmove\":\"%s\",\"score\":%d,\"nodes\":%llu,\"seconds\":%.6f,\"nps\":%.0f}",
+                 i > 0 ? "," : "", entry.name.c_str(), entry.fen, entry.bestMove.c_str(), entry.score,
+                 (unsigned long long)entry.nodes, entry.seconds, entry.nodes / max(entry.seconds, 1e-9));
+        json += buffer;
+    }
+    return json + "]}\n";
+}
+
+// --- Baseline Comparison ---
+
+// Minimal reader for the JSON that benchJson writes: flattens a value into "path" -> text
+// pairs such as "signature" or "positions.3.nodes", so no JSON library is needed
+struct JsonReader {
+    const string& text;
+    size_t i = 0;
+    map<string, string> values;
+
+    void skipSpace() {
+        while (i < text.size() && isspace((unsigned char)text[i])) ++i;
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (i >= text.size() || text[i] != c) return false;
+        ++i;
+        return true;
+    }
+
+    bool readString(string& value) {
+        if (!consume('"')) return false;
+        for (; i < text.size() && text[i] != '"'; ++i) {
+            if (text[i] == '\\' && i + 1 < text.size()) ++i;
+            value += text[i];
+        }
+        return consume('"');
+    }
+
+    bool readValue(const string& path) {
+        skipSpace();
+        if (i >= text.size()) return false;
+        char open = text[i];
+        if (open == '{' || open == '[') {
+            ++i;
+            char close = open == '{' ? '}' : ']';
+            if (consume(close)) return true;
+            for (int index = 0;; ++index) {
+                string name = to_string(index);
+                if (open == '{') {
+                    name.clear();
+                    if (!readString(name) || !consume(':')) return false;
+                }
+                if (!readValue(path.empty() ? name : path + "." + name)) return false;
+                if (consume(close)) return true;
+                if (!consume(',')) return false;
+            }
+        }
+        string value;
+        if (open == '"') {
+            if (!readString(value)) return false;
+        }
+        else {
+            while (i < text.size() && !isspace((unsigned char)text[i]) && !strchr(",:]}", text[i])) value += text[i++];
+            if (value.empty()) return false;
+        }
+        values[path] = value;
+        return true;
+    }
+};
+
+static bool readBaseline(const string& path, map<string, string>& values) {
+    ifstream file(path);
+    if (!file) return false;
+    stringstream contents;
+    contents << file.rdbuf();
+    string text = contents.str();
+    JsonReader reader{ text };
+    if (!reader.readValue("")) return false;
+    values = move(reader.values);
+    return values.count("signature") && values.count("seconds");
+}
+
+// Compare with a baseline run. A changed signature means the search now visits other
+// nodes; that is reported but only time to depth decides whether this run regressed.
+// Returns 0 if it did not, 1 if it did and 2 if the runs cannot be compared.
+static int compareWithBaseline(const BenchResult& bench, const string& path, double thresholdPercent) {
+    map<string, string> baseline;
+    if (!readBaseline(path, baseline)) {
+        fprintf(stderr, "cannot read baseline '%s'\n", path.c_str());
+        return 2;
+    }
+    int depth = atoi(baseline["depth"].c_str());
+    size_t hashMB = strtoul(baseline["hashMB"].c_str(), nullptr, 10);
+    if (depth != bench.depth || hashMB != bench.hashMB) {
+        printf("baseline searched at depth %d with %zu MB; run with --depth %d --hash %zu to compare\n",
+               depth, hashMB, depth, hashMB);
+        return 2;
+    }
+
+    uint64_t signature = strtoull(baseline["signature"].c_str(), nullptr, 10);
+    if (signature == bench.nodes) {
+        printf("signature %llu matches the baseline\n", (unsigned long long)signature);
+    }
+    else {
+        printf("signature %llu differs from the baseline's %llu; changed positions:\n", (unsigned long long)bench.nodes,
+               (unsigned long long)signature);
+        for (size_t i = 0; i < bench.positions.size(); ++i) {
+            string prefix = "positions." + to_string(i) + ".";
+            const PositionResult& entry = bench.positions[i];
+            uint64_t nodes = strtoull(baseline[prefix + "nodes"].c_str(), nullptr, 10);
+            if (baseline[prefix + "fen"] != entry.fen) printf("  %-14s not in the baseline\n", entry.name.c_str());
+            else if (nodes != entry.nodes) {
+                printf("  %-14s %12llu nodes (baseline %llu, %+.1f%%)\n", entry.name.c_str(), (unsigned long long)entry.nodes,
+                       (unsigned long long)nodes, 100.0 * ((double)entry.nodes / max<uint64_t>(nodes, 1) - 1.0));
+            }
+        }
+    }
+
+    double baselineSeconds = atof(baseline["seconds"].c_str());
+    double baselineNps = signature / max(baselineSeconds, 1e-9);
+    double timeChange = 100.0 * (bench.seconds / max(baselineSeconds, 1e-9) - 1.0);
+    double npsChange = 100.0 * (bench.nodes / max(bench.seconds, 1e-9) / max(baselineNps, 1e-9) - 1.0);
+    printf("time to depth %.3f s (baseline %.3f s, %+.1f%%), %+.1f%% nodes/s\n", bench.seconds, baselineSeconds,
+           timeChange, npsChange);
+    if (timeChange > thresholdPercent) {
+        printf("REGRESSION: time to depth is %.1f%% above the baseline (threshold %.1f%%)\n", timeChange, thresholdPercent);
+        return 1;
+    }
+    printf("no regression (threshold %.1f%%)\n", thresholdPercent);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    BenchResult bench;
+    bench.depth = DEFAULT_BENCH_DEPTH;
+    bench.hashMB = DEFAULT_HASH_MB;
+    bench.runs = DEFAULT_BENCH_RUNS;
+    string jsonPath, baselinePath;
+    double thresholdPercent = DEFAULT_REGRESSION_PERCENT;
+
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--help" || option == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if (option == "--depth" && i + 1 < argc) bench.depth = max(1, atoi(argv[++i]));
+        else if (option == "--runs" && i + 1 < argc) bench.runs = max(1, atoi(argv[++i]));
+        else if (option == "--hash" && i + 1 < argc) bench.hashMB = strtoul(argv[++i], nullptr, 10);
+        else if (option == "--json" && i + 1 < argc) jsonPath = argv[++i];
+        else if (option == "--baseline" && i + 1 < argc) baselinePath = argv[++i];
+        else if (option == "--threshold" && i + 1 < argc) thresholdPercent = atof(argv[++i]);
+        else {
+            fprintf(stderr, "%s: unknown or incomplete option '%s'\n", argv[0], option.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    transpositionTable.resize(bench.hashMB);
+    if (!runSuite(bench)) return 2;
+
+    if (!jsonPath.empty()) {
+        ofstream file(jsonPath);
+        if (!(file << benchJson(bench))) {
+            fprintf(stderr, "%s: cannot write '%s'\n", argv[0], jsonPath.c_str());
+            return 2;
+        }
+        printf("results written to %s\n", jsonPath.c_str());
+    }
+
+    int status = bench.deterministic ? 0 : 1;
+    if (!baselinePath.empty()) status = max(status, compareWithBaseline(bench, baselinePath, thresholdPercent));
+    return status;
+}
@@ -0,0 +1,106 @@
+// Opening book builder: searches the positions of the first few plies deeply and
+// writes the chosen moves as a sorted binary book, or looks up one position.
+
+#include "board.h"
+#include "opening_book.h"
+#include "transposition_table.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace std;
+
+const char* DEFAULT_BOOK_PATH = "opening.book";
+const int DEFAULT_BOOK_PLIES = 8;
+const int DEFAULT_BOOK_DEPTH = 13;
+
+static void printUsage(const char* program) {
+    printf("Usage: %s [options]\n"
+           "  --out <file>       Book file to write (default \"%s\")\n"
+           "  --plies <plies>    Cover the first this many plies (default %d)\n"
+           "  --depth <plies>    Search depth for every book position (default %d)\n"
+           "  --threads <count>  Search threads (default 1)\n"
+           "  --hash <MB>        Transposition table size in megabytes (default %zu)\n"
+           "  --probe <FEN>      Look up one position in the --out book instead of building\n"
+           "  --help             Show this help\n",
+           program, DEFAULT_BOOK_PATH, DEFAULT_BOOK_PLIES, DEFAULT_BOOK_DEPTH, DEFAULT_HASH_MB);
+}
+
+static int probePosition(const string& path, const string& fen) {
+    Bitboard board;
+    char sideToMove;
+    if (!parseFen(fen, board, sideToMove)) {
+        fprintf(stderr, "invalid FEN '%s'\n", fen.c_str());
+        return 2;
+    }
+    if (!openingBook.load(path)) {
+        fprintf(stderr, "cannot read book '%s'\n", path.c_str());
+        return 2;
+    }
+    BitMove move;
+    BookEntry entry;
+    if (!openingBook.probe(board, generateLegalMoves(board, sideToMove), move, entry)) {
+        printf("not in book\n");
+        return 1;
+    }
+    printf("bookmove %s score %d depth %d\n", moveToString(move).c_str(), entry.score, entry.depth);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    string path = DEFAULT_BOOK_PATH;
+    int plies = DEFAULT_BOOK_PLIES;
+    int depth = DEFAULT_BOOK_DEPTH;
+    int threads = 1;
+    size_t hashMB = DEFAULT_HASH_MB;
+    string probeFen;
+
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--help" || option == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if (option == "--out" && i + 1 < argc) path = argv[++i];
+        else if (option == "--plies" && i + 1 < argc) plies = atoi(argv[++i]);
+        else if (option == "--depth" && i + 1 < argc) depth = atoi(argv[++i]);
+        else if (option == "--threads" && i + 1 < argc) threads = max(1, atoi(argv[++i]));
+        else if (option == "--hash" && i + 1 < argc) hashMB = strtoul(argv[++i], nullptr, 10);
+        else if (option == "--probe" && i + 1 < argc) probeFen = argv[++i];
+        else {
+            fprintf(stderr, "%s: unknown or incomplete option '%s'\n", argv[0], option.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (!probeFen.empty()) return probePosition(path, probeFen);
+
+    if (plies < 1 || depth < 1) {
+        fprintf(stderr, "%s: --plies and --depth must be positive\n", argv[0]);
+        return 2;
+    }
+
+    transpositionTable.resize(hashMB);
+    printf("building a %d-ply book at depth %d\n", plies, depth);
+    auto start = chrono::steady_clock::now();
+    vector<BookEntry> entries = buildOpeningBook(plies, depth, threads,
+        [](size_t positions, const Bitboard& board, char sideToMove, const BookEntry& entry) {
+            if (positions % 100 == 0) {
+                printf("%zu positions, last %s %d-%d score %d\n", positions, toFen(board, sideToMove).c_str(),
+                       entry.from + 1, entry.to + 1, entry.score);
+                fflush(stdout);
+            }
+        });
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (!writeOpeningBook(path, entries)) {
+        fprintf(stderr, "%s: cannot write '%s'\n", argv[0], path.c_str());
+        return 1;
+    }
+    printf("wrote %zu positions to %s in %.1f s\n", entries.size(), path.c_str(), seconds);
+    return 0;
+}
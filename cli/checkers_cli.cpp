@@ -0,0 +1,298 @@
+// Headless command-line front end for the checkers engine (no Qt dependency).
+// Searches one position and prints the best move, or runs the thread benchmark.
+
+#include "allocation_counter.h"
+#include "board.h"
+#include "opening_book.h"
+#include "search.h"
+#include "tablebase.h"
+#include "transposition_table.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// --- Parallel Search Benchmark ---
+
+// Fixed depth used by --bench-smp unless --depth is given
+const int DEFAULT_BENCH_DEPTH = 13;
+
+// Benchmark positions: the start position plus positions reached by fixed-seed
+// random play, always with White (the AI) to move
+static vector<Bitboard> benchmarkPositions() {
+    vector<Bitboard> positions = { toBitboard(initializeBoard()) };
+    uint32_t seed = 12345;
+    for (int plies : { 8, 14, 20, 26 }) {
+        Bitboard board = toBitboard(initializeBoard());
+        char player = WHITE;
+        for (int ply = 0; ply < plies; ++ply) {
+            vector<BitMove> moves = generateLegalMoves(board, player);
+            if (moves.empty()) break;
+            seed = seed * 1103515245u + 12345u;
+            board = applyMove(board, moves[(seed >> 16) % moves.size()]);
+            player = opponentOf(player);
+        }
+        if (player == WHITE && !generateLegalMoves(board, WHITE).empty()) positions.push_back(board);
+    }
+    return positions;
+}
+
+// Count the heap allocations of one single-threaded search. The search's buffers are
+// allocated once up front, so the count must not grow with depth (or node count).
+static bool checkSteadyStateAllocations(const Bitboard& position, int depth) {
+    uint64_t counts[2];
+    uint64_t nodes[2];
+    int depths[2] = { 1, depth };
+    for (int i = 0; i < 2; ++i) {
+        transpositionTable.clear();
+        uint64_t before = allocationCount();
+        nodes[i] = findBestMove(position, WHITE, depths[i], 0, 1).nodes;
+        counts[i] = allocationCount() - before;
+    }
+    bool steady = counts[0] == counts[1];
+    printf("allocations per search: %llu at depth %d (%llu nodes), %llu at depth %d (%llu nodes)%s\n",
+           (unsigned long long)counts[0], depths[0], (unsigned long long)nodes[0],
+           (unsigned long long)counts[1], depths[1], (unsigned long long)nodes[1],
+           steady ? ", none per node" : ", SEARCH ALLOCATES PER NODE");
+    return steady;
+}
+
+// Search every benchmark position at a fixed depth with 1, 2, 4, ... maxThreads threads,
+// print nodes, NPS, speedup and allocations per thread count, and check that every
+// thread count returns the same scores and best moves as the single-threaded search.
+// pvs selects principal variation search with aspiration windows, for node comparisons.
+// Returns false on a score or best move mismatch or if the search allocates per node.
+static bool runSmpBenchmark(int depth, int maxThreads, bool pvs) {
+    vector<Bitboard> positions = benchmarkPositions();
+    vector<int> referenceScores;
+    vector<BitMove> referenceMoves;
+    double referenceSeconds = 0.0;
+    bool deterministic = true;
+    bool steady = checkSteadyStateAllocations(positions.front(), depth);
+
+    printf("%-8s %14s %10s %14s %8s %12s\n", "threads", "nodes", "seconds", "nps", "speedup", "allocations");
+    for (int threads = 1; threads <= maxThreads; threads = threads < maxThreads ? min(threads * 2, maxThreads) : threads + 1) {
+        uint64_t nodes = 0;
+        double seconds = 0.0;
+        uint64_t allocationsBefore = allocationCount();
+        for (size_t i = 0; i < positions.size(); ++i) {
+            transpositionTable.clear();
+            SearchOptions options;
+            options.maxDepth = depth;
+            options.threads = threads;
+            options.pvs = pvs;
+            SearchResult result = findBestMove(positions[i], WHITE, options);
+            nodes += result.nodes;
+            seconds += result.seconds;
+            if (threads == 1) {
+                referenceScores.push_back(result.score);
+                referenceMoves.push_back(result.bestMove);
+            }
+            else if (result.score != referenceScores[i]) {
+                printf("score mismatch on position %zu: %d threads gave %d, 1 thread gave %d\n", i, threads, result.score, referenceScores[i]);
+                deterministic = false;
+            }
+            else if (result.bestMove.from != referenceMoves[i].from || result.bestMove.to != referenceMoves[i].to) {
+                printf("best move mismatch on position %zu: %d threads chose %s, 1 thread chose %s\n", i, threads,
+                       moveToString(result.bestMove).c_str(), moveToString(referenceMoves[i]).c_str());
+                deterministic = false;
+            }
+        }
+        if (threads == 1) referenceSeconds = seconds;
+        printf("%-8d %14llu %10.3f %14.0f %8.2f %12llu\n", threads, (unsigned long long)nodes, seconds,
+               nodes / max(seconds, 1e-9), referenceSeconds / max(seconds, 1e-9),
+               (unsigned long long)(allocationCount() - allocationsBefore));
+    }
+    printf(deterministic ? "scores and best moves identical for all thread counts\n" : "SCORE OR BEST MOVE MISMATCH\n");
+    return deterministic && steady;
+}
+
+// --- Evaluation Benchmark ---
+
+// Leaf positions (as evaluation terms) collected by --bench-eval, and how often each batch is scored
+const size_t EVAL_BENCH_POSITIONS = 1 << 16;
+const int EVAL_BENCH_ROUNDS = 200;
+
+// The children of every position along fixed-seed random games, as the frontier sees them
+static vector<EvalTerms> frontierPositions() {
+    vector<EvalTerms> positions;
+    uint32_t seed = 54321;
+    while (positions.size() < EVAL_BENCH_POSITIONS) {
+        Bitboard board = toBitboard(initializeBoard());
+        char player = WHITE;
+        for (vector<BitMove> moves = generateLegalMoves(board, player); !moves.empty(); moves = generateLegalMoves(board, player)) {
+            for (const BitMove& move : moves) positions.push_back(evalTermsAfterMove(board, move));
+            seed = seed * 1103515245u + 12345u;
+            board = applyMove(board, moves[(seed >> 16) % moves.size()]);
+            player = opponentOf(player);
+        }
+    }
+    positions.resize(EVAL_BENCH_POSITIONS);
+    return positions;
+}
+
+// Score the same leaf positions one at a time and in frontier-sized batches, print
+// the throughput of both, and check that the batched kernel agrees with evaluateBoard.
+// Returns false on any disagreement.
+static bool runEvalBenchmark() {
+    using BenchClock = chrono::steady_clock;
+    vector<EvalTerms> positions = frontierPositions();
+    EvalWeights weights;
+    vector<int> single(positions.size()), batched(positions.size());
+
+    BenchClock::time_point start = BenchClock::now();
+    for (int round = 0; round < EVAL_BENCH_ROUNDS; ++round) {
+        Bitboard board = {};
+        for (size_t i = 0; i < positions.size(); ++i) {
+            board.terms = positions[i];
+            single[i] = evaluateBoard(board, weights);
+        }
+    }
+    double singleSeconds = chrono::duration<double>(BenchClock::now() - start).count();
+
+    // Batches of varying size, like the move counts of frontier nodes
+    start = BenchClock::now();
+    for (int round = 0; round < EVAL_BENCH_ROUNDS; ++round) {
+        for (size_t i = 0, size = 1; i < positions.size(); i += size, size = size % 15 + 1) {
+            size_t count = min(size, positions.size() - i);
+            evaluateBoards(&positions[i], count, weights, &batched[i]);
+        }
+    }
+    double batchedSeconds = chrono::duration<double>(BenchClock::now() - start).count();
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < positions.size(); ++i) mismatches += batched[i] != single[i];
+    double evaluations = (double)positions.size() * EVAL_BENCH_ROUNDS;
+    printf("%-18s %14.0f evaluations/s\n", "one at a time", evaluations / max(singleSeconds, 1e-9));
+    printf("%-18s %14.0f evaluations/s  (%s kernel, %.2fx)\n", "batched", evaluations / max(batchedSeconds, 1e-9),
+           evaluationKernelName(), singleSeconds / max(batchedSeconds, 1e-9));
+    if (mismatches > 0) printf("BATCHED EVALUATION DIFFERS on %zu of %zu positions\n", mismatches, positions.size());
+    else printf("batched and single evaluations agree on %zu positions\n", positions.size());
+    return mismatches == 0;
+}
+
+static void printUsage(const char* program) {
+    printf("Usage: %s [options]\n"
+           "  --fen <FEN>        Position to search, e.g. \"W:W21,22,K30:B1,2\" (default: start position)\n"
+           "  --depth <plies>    Maximum search depth (default %d, unlimited with --movetime)\n"
+           "  --movetime <ms>    Time budget for the search in milliseconds\n"
+           "  --threads <count>  Number of search threads (default 1)\n"
+           "  --hash <MB>        Transposition table size in megabytes (default %zu)\n"
+           "  --tablebases <dir> Probe the endgame tables built by checkers_tbgen in this directory\n"
+           "  --book <file>      Play from the opening book built by checkers_book\n"
+           "  --eval <file>      Evaluation weights written by checkers_tune\n"
+           "  --bench-smp        Benchmark 1, 2, 4, ... --threads threads at a fixed --depth (default %d)\n"
+           "  --bench-eval       Benchmark and cross-check the batched leaf evaluation\n"
+           "  --no-pvs           Search every move with the full window (for node count comparisons)\n"
+           "  --stats            Also print the search statistics per depth as JSON\n"
+           "  --help             Show this help\n",
+           program, DEFAULT_SEARCH_DEPTH, DEFAULT_HASH_MB, DEFAULT_BENCH_DEPTH);
+}
+
+// Parse a non-negative integer option value; exits with usage on error
+static long parseNumber(const char* program, const string& option, const char* value) {
+    char* end = nullptr;
+    long number = value ? strtol(value, &end, 10) : -1;
+    if (!value || *end != '\0' || number < 0) {
+        fprintf(stderr, "%s: %s expects a non-negative number\n", program, option.c_str());
+        printUsage(program);
+        exit(2);
+    }
+    return number;
+}
+
+int main(int argc, char* argv[]) {
+    string fen = START_FEN;
+    int depth = -1;
+    int moveTimeMs = 0;
+    int threads = 1;
+    size_t hashMB = DEFAULT_HASH_MB;
+    bool benchSmp = false;
+    bool benchEval = false;
+    bool pvs = true;
+    bool stats = false;
+    string tablebaseDirectory;
+    string bookPath;
+    string evalPath;
+
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (option == "--help" || option == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if (option == "--bench-smp") benchSmp = true;
+        else if (option == "--bench-eval") benchEval = true;
+        else if (option == "--no-pvs") pvs = false;
+        else if (option == "--stats") stats = true;
+        else if (option == "--fen" && value) { fen = value; ++i; }
+        else if (option == "--tablebases" && value) { tablebaseDirectory = value; ++i; }
+        else if (option == "--book" && value) { bookPath = value; ++i; }
+        else if (option == "--eval" && value) { evalPath = value; ++i; }
+        else if (option == "--depth") { depth = max(1L, parseNumber(argv[0], option, value)); ++i; }
+        else if (option == "--movetime") { moveTimeMs = (int)parseNumber(argv[0], option, value); ++i; }
+        else if (option == "--threads") { threads = (int)clamp(parseNumber(argv[0], option, value), 1L, (long)MAX_SEARCH_THREADS); ++i; }
+        else if (option == "--hash") { hashMB = parseNumber(argv[0], option, value); ++i; }
+        else {
+            fprintf(stderr, "%s: unknown or incomplete option '%s'\n", argv[0], option.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    transpositionTable.resize(hashMB);
+    if (!tablebaseDirectory.empty() && tablebases.load(tablebaseDirectory) == 0) {
+        fprintf(stderr, "%s: no endgame tables found in '%s'\n", argv[0], tablebaseDirectory.c_str());
+    }
+    if (!bookPath.empty() && !openingBook.load(bookPath)) {
+        fprintf(stderr, "%s: cannot read opening book '%s'\n", argv[0], bookPath.c_str());
+        return 2;
+    }
+    EvalWeights weights;
+    if (!evalPath.empty() && !loadEvalWeights(evalPath, weights)) {
+        fprintf(stderr, "%s: cannot read evaluation weights '%s'\n", argv[0], evalPath.c_str());
+        return 2;
+    }
+
+    if (benchEval) return runEvalBenchmark() ? 0 : 1;
+    if (benchSmp) {
+        return runSmpBenchmark(depth > 0 ? depth : DEFAULT_BENCH_DEPTH, threads, pvs) ? 0 : 1;
+    }
+
+    Bitboard board;
+    char sideToMove;
+    if (!parseFen(fen, board, sideToMove)) {
+        fprintf(stderr, "%s: invalid FEN '%s'\n", argv[0], fen.c_str());
+        return 2;
+    }
+
+    // With only a time budget the search deepens as far as the clock allows
+    if (depth < 0) depth = moveTimeMs > 0 ? MAX_SEARCH_DEPTH : DEFAULT_SEARCH_DEPTH;
+
+    SearchOptions options;
+    options.maxDepth = depth;
+    options.timeLimitMs = moveTimeMs;
+    options.threads = threads;
+    options.pvs = pvs;
+    options.weights = weights;
+    SearchResult result = findBestMove(board, sideToMove, options);
+    if (!result.hasMove) {
+        printf("bestmove none\n");
+        return 0;
+    }
+    if (result.fromBook) {
+        printf("bestmove %s score %d depth %d book\n", moveToString(result.bestMove).c_str(), result.score, result.depth);
+        return 0;
+    }
+    printf("bestmove %s score %d depth %d nodes %llu qnodes %llu nps %.0f time %.3f\n",
+           moveToString(result.bestMove).c_str(), result.score, result.depth, (unsigned long long)result.nodes,
+           (unsigned long long)result.quiescenceNodes, result.nodes / max(result.seconds, 1e-9), result.seconds);
+    if (stats) printf("%s\n", searchStatsJson(result).c_str());
+    return 0;
+}
@@ -0,0 +1,206 @@
+// Game log tool: lists and prints the games of a log written by the GUI or
+// checkers_match, exports their positions as training data, and indexes and
+// looks up positions by their Zobrist key.
+
+#include "board.h"
+#include "game_log.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static void printUsage(const char* program) {
+    printf("Usage: %s --log <file> [options]\n"
+           "  --log <file>        Game log written by the GUI's or checkers_match's --log\n"
+           "                      Without other options, list the games with their offsets\n"
+           "  --show <offset>     Print one game move by move with the search behind each move\n"
+           "  --positions <file>  Append every position of every finished game with its result, for checkers_tune\n"
+           "  --index <file>      Create this position index, or extend it with the games logged since\n"
+           "  --find <FEN>        Look a position up in the --index and print the moves played from it\n"
+           "  --help              Show this help\n",
+           program);
+}
+
+static const char* resultName(int result) {
+    return result == GAME_UNFINISHED ? "*" : result > 0 ? "1-0" : result < 0 ? "0-1" : "1/2-1/2";
+}
+
+static const char* sourceName(MoveSource source) {
+    return source == MOVE_FROM_BOOK ? "book" : source == MOVE_BY_HUMAN ? "human" : "search";
+}
+
+static string startedAt(int64_t startTime) {
+    time_t seconds = (time_t)startTime;
+    char text[32];
+    tm* utc = gmtime(&seconds);
+    if (!utc || !strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", utc)) return "?";
+    return text;
+}
+
+static int listGames(GameLogReader& reader) {
+    auto start = chrono::steady_clock::now();
+    size_t games = 0, moves = 0;
+    LoggedGame game;
+    printf("%12s  %-19s  %5s  %-7s  %s\n", "offset", "started (UTC)", "plies", "result", "start position");
+    while (reader.next(game)) {
+        printf("%12llu  %-19s  %5zu  %-7s  %s\n", (unsigned long long)game.offset, startedAt(game.startTime).c_str(),
+               game.moves.size(), resultName(game.result), toFen(game.start, game.startSide).c_str());
+        ++games;
+        moves += game.moves.size();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    printf("%zu games, %zu moves read in %.2f s\n", games, moves, seconds);
+    return 0;
+}
+
+static int showGame(GameLogReader& reader, uint64_t offset) {
+    LoggedGame game;
+    vector<Bitboard> positions;
+    if (!reader.seek(offset) || !reader.next(game) || game.offset != offset) {
+        fprintf(stderr, "no game starts at offset %llu\n", (unsigned long long)offset);
+        return 2;
+    }
+    bool replayed = replayLoggedGame(game, positions);
+    printf("started %s UTC  result %s  from %s\n", startedAt(game.startTime).c_str(), resultName(game.result),
+           toFen(game.start, game.startSide).c_str());
+    printf("%5s %-5s %-8s %-6s %5s %7s %12s %8s\n", "ply", "side", "move", "source", "depth", "score", "nodes", "ms");
+    char sideToMove = game.startSide;
+    for (size_t ply = 0; ply < game.moves.size(); ++ply) {
+        const LoggedMove& move = game.moves[ply];
+        printf("%5zu %-5s %-8s %-6s %5d %7d %12llu %8u\n", ply + 1, sideToMove == WHITE ? "white" : "black",
+               moveToString(move.move).c_str(), sourceName(move.source), move.depth, move.score,
+               (unsigned long long)move.nodes, move.timeMs);
+        sideToMove = opponentOf(sideToMove);
+    }
+    if (!replayed) printf("the log is damaged: a move does not fit its position\n");
+    else printf("final position %s\n", toFen(positions.back(), sideToMove).c_str());
+    return replayed ? 0 : 1;
+}
+
+// Training positions for checkers_tune, in the format of checkers_match --positions
+static int exportPositions(GameLogReader& reader, const string& path) {
+    FILE* file = fopen(path.c_str(), "a");
+    if (!file) {
+        fprintf(stderr, "cannot open '%s'\n", path.c_str());
+        return 2;
+    }
+    size_t games = 0, lines = 0;
+    LoggedGame game;
+    vector<Bitboard> positions;
+    while (reader.next(game)) {
+        if (game.result == GAME_UNFINISHED || !replayLoggedGame(game, positions)) continue;
+        const char* result = resultName(game.result);
+        char sideToMove = game.startSide;
+        for (const Bitboard& board : positions) {
+            fprintf(file, "%s %s\n", toFen(board, sideToMove).c_str(), result);
+            sideToMove = opponentOf(sideToMove);
+        }
+        ++games;
+        lines += positions.size();
+    }
+    bool written = fclose(file) == 0;
+    printf("appended %zu positions of %zu finished games to %s\n", lines, games, path.c_str());
+    return written ? 0 : 1;
+}
+
+static int updateIndex(const string& logPath, const string& indexPath) {
+    auto start = chrono::steady_clock::now();
+    GameLogIndex index;
+    bool existing = index.load(indexPath);
+    size_t before = index.size();
+    if (!index.update(logPath)) {
+        fprintf(stderr, "cannot index '%s': not a game log, or shorter than the part already indexed\n", logPath.c_str());
+        return 2;
+    }
+    if (!index.save(indexPath)) {
+        fprintf(stderr, "cannot write '%s'\n", indexPath.c_str());
+        return 1;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    printf("%s %s: %zu positions added, %zu in total, %llu log bytes indexed, %.2f s\n", existing ? "extended" : "created",
+           indexPath.c_str(), index.size() - before, index.size(), (unsigned long long)index.indexedBytes(), seconds);
+    return 0;
+}
+
+static int findPosition(GameLogReader& reader, const string& indexPath, const string& fen) {
+    Bitboard board;
+    char sideToMove;
+    if (!parseFen(fen, board, sideToMove)) {
+        fprintf(stderr, "invalid FEN '%s'\n", fen.c_str());
+        return 2;
+    }
+    GameLogIndex index;
+    if (!index.load(indexPath)) {
+        fprintf(stderr, "cannot read index '%s'\n", indexPath.c_str());
+        return 2;
+    }
+    vector<GameIndexEntry> found = index.find(board.hash);
+    LoggedGame game;
+    size_t shown = 0;
+    for (const GameIndexEntry& entry : found) {
+        if (!reader.seek(entry.gameOffset) || !reader.next(game)) continue;
+        if (entry.ply >= game.moves.size()) {
+            printf("game %12llu  ply %3u  last position, result %s\n", (unsigned long long)entry.gameOffset, entry.ply,
+                   resultName(game.result));
+        }
+        else {
+            const LoggedMove& move = game.moves[entry.ply];
+            printf("game %12llu  ply %3u  %-8s %-6s depth %2d score %6d  result %s\n", (unsigned long long)entry.gameOffset,
+                   entry.ply, moveToString(move.move).c_str(), sourceName(move.source), move.depth, move.score,
+                   resultName(game.result));
+        }
+        ++shown;
+    }
+    printf("%zu occurrences\n", shown);
+    return shown > 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    string logPath, positionsPath, indexPath, findFen;
+    long long showOffset = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--help" || option == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if (option == "--log" && i + 1 < argc) logPath = argv[++i];
+        else if (option == "--show" && i + 1 < argc) showOffset = strtoll(argv[++i], nullptr, 10);
+        else if (option == "--positions" && i + 1 < argc) positionsPath = argv[++i];
+        else if (option == "--index" && i + 1 < argc) indexPath = argv[++i];
+        else if (option == "--find" && i + 1 < argc) findFen = argv[++i];
+        else {
+            fprintf(stderr, "%s: unknown or incomplete option '%s'\n", argv[0], option.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (logPath.empty()) {
+        fprintf(stderr, "%s: --log is required\n", argv[0]);
+        printUsage(argv[0]);
+        return 2;
+    }
+    GameLogReader reader;
+    if (!reader.open(logPath)) {
+        fprintf(stderr, "%s: cannot read game log '%s'\n", argv[0], logPath.c_str());
+        return 2;
+    }
+    if (!findFen.empty()) {
+        if (indexPath.empty()) {
+            fprintf(stderr, "%s: --find needs an --index\n", argv[0]);
+            return 2;
+        }
+        return findPosition(reader, indexPath, findFen);
+    }
+    if (!indexPath.empty()) return updateIndex(logPath, indexPath);
+    if (!positionsPath.empty()) return exportPositions(reader, positionsPath);
+    if (showOffset >= 0) return showGame(reader, (uint64_t)showOffset);
+    return listGames(reader);
+}
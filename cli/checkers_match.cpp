@@ -0,0 +1,401 @@
+// Engine-vs-engine tournament runner: plays many games between two search
+// configurations in parallel, streams the games as PDN and reports the Elo
+// difference with its 95% error bar and the throughput in games per hour.
+
+#include "board.h"
+#include "game_log.h"
+#include "opening_book.h"
+#include "search.h"
+#include "tablebase.h"
+#include "transposition_table.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+using MatchClock = chrono::steady_clock;
+
+const int DEFAULT_MATCH_GAMES = 100;
+const int DEFAULT_RANDOM_PLIES = 4;
+const int DEFAULT_MAX_PLIES = 300;
+const size_t DEFAULT_MATCH_HASH_MB = 16;
+
+// One side of the match
+struct EngineConfig {
+    string spec; // As given on the command line, used as the player name
+    SearchOptions options;
+};
+
+// Parse "depth=9,movetime=100,eval=tuned.eval,king=300"; returns false on an unknown key or bad value.
+// Keys apply in order, so a weight after eval=<file> overrides the file.
+static bool parseEngineConfig(const string& spec, EngineConfig& config) {
+    config.spec = spec;
+    config.options.maxDepth = DEFAULT_SEARCH_DEPTH;
+    stringstream items(spec);
+    string item;
+    bool hasDepth = false;
+    while (getline(items, item, ',')) {
+        size_t equals = item.find('=');
+        if (equals == string::npos) return false;
+        string key = item.substr(0, equals);
+        if (key == "eval") {
+            if (!loadEvalWeights(item.substr(equals + 1), config.options.weights)) return false;
+            continue;
+        }
+        char* end = nullptr;
+        long value = strtol(item.c_str() + equals + 1, &end, 10);
+        if (*end != '\0') return false;
+        if (setEvalWeight(config.options.weights, key, (int)value)) continue; // Weights may be negative
+        if (value < 0) return false;
+        if (key == "depth") { config.options.maxDepth = max(1L, value); hasDepth = true; }
+        else if (key == "movetime") config.options.timeLimitMs = (int)value;
+        else if (key == "quiescence") config.options.quiescence = value != 0;
+        else if (key == "pvs") config.options.pvs = value != 0;
+        else return false;
+    }
+    // With only a time budget the search deepens as far as the clock allows
+    if (!hasDepth && config.options.timeLimitMs > 0) config.options.maxDepth = MAX_SEARCH_DEPTH;
+    return true;
+}
+
+// Start position of a game; every opening is played twice with colours swapped
+struct Opening {
+    Bitboard board;
+    char sideToMove;
+};
+
+// The start position followed by `plies` random legal moves (seeded per opening)
+static Opening randomOpening(uint32_t seed, int plies) {
+    for (;; ++seed) {
+        Opening opening = { toBitboard(initializeBoard()), WHITE };
+        uint32_t state = seed * 2654435761u + 1;
+        int ply = 0;
+        for (; ply < plies; ++ply) {
+            vector<BitMove> moves = generateLegalMoves(opening.board, opening.sideToMove);
+            if (moves.empty()) break;
+            state = state * 1103515245u + 12345u;
+            opening.board = applyMove(opening.board, moves[(state >> 16) % moves.size()]);
+            opening.sideToMove = opponentOf(opening.sideToMove);
+        }
+        if (ply == plies && !generateLegalMoves(opening.board, opening.sideToMove).empty()) return opening;
+    }
+}
+
+// One line per FEN; returns false if the file cannot be read or holds an invalid FEN
+static bool readOpenings(const string& path, vector<Opening>& openings) {
+    ifstream file(path);
+    if (!file) return false;
+    string line;
+    while (getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        Opening opening;
+        if (!parseFen(line, opening.board, opening.sideToMove)) return false;
+        openings.push_back(opening);
+    }
+    return !openings.empty();
+}
+
+struct GameRecord {
+    int round;
+    bool engineAIsWhite;
+    Opening opening;
+    int64_t startTime;     // Unix time in seconds
+    vector<LoggedMove> moves; // With the search behind each move, for --log
+    int result;         // +1 White won, -1 Black won, 0 draw
+    const char* reason;
+};
+
+struct MatchSettings {
+    EngineConfig engines[2]; // A and B
+    int games = DEFAULT_MATCH_GAMES;
+    int randomPlies = DEFAULT_RANDOM_PLIES;
+    int maxPlies = DEFAULT_MAX_PLIES;
+    size_t hashMB = DEFAULT_MATCH_HASH_MB;
+    uint32_t seed = 1;
+    vector<Opening> openings; // From --openings; random openings when empty
+};
+
+// Play one game to the end. tables holds one transposition table per engine.
+static GameRecord playGame(const MatchSettings& settings, int round, TranspositionTable tables[2]) {
+    GameRecord game = {};
+    game.round = round;
+    game.engineAIsWhite = round % 2 == 0;
+    int openingIndex = round / 2;
+    game.opening = settings.openings.empty() ? randomOpening(settings.seed + openingIndex, settings.randomPlies)
+                                             : settings.openings[openingIndex % settings.openings.size()];
+    for (int i = 0; i < 2; ++i) tables[i].clear();
+    game.startTime = time(nullptr);
+
+    Bitboard board = game.opening.board;
+    char sideToMove = game.opening.sideToMove;
+    unordered_map<uint64_t, int> seen; // Positions (with side to move) and how often they occurred
+    for (int ply = 0;; ++ply) {
+        if (generateLegalMoves(board, sideToMove).empty()) {
+            game.result = sideToMove == WHITE ? -1 : 1;
+            game.reason = "no legal moves";
+            return game;
+        }
+        if (++seen[board.hash] == 3) {
+            game.result = 0;
+            game.reason = "threefold repetition";
+            return game;
+        }
+        if (ply >= settings.maxPlies) {
+            game.result = 0;
+            game.reason = "move limit";
+            return game;
+        }
+        TablebaseOutcome outcome;
+        int plies;
+        if (tablebases.probe(board, sideToMove, outcome, plies)) {
+            game.result = sideToMove == WHITE ? outcome : -outcome;
+            game.reason = "tablebase adjudication";
+            return game;
+        }
+
+        int engine = (sideToMove == WHITE) == game.engineAIsWhite ? 0 : 1;
+        SearchOptions options = settings.engines[engine].options;
+        options.table = &tables[engine];
+        SearchResult result = findBestMove(board, sideToMove, options);
+        game.moves.push_back(loggedMove(result));
+        board = applyMove(board, result.bestMove);
+        sideToMove = opponentOf(sideToMove);
+    }
+}
+
+// The game as a game log entry
+static LoggedGame toLoggedGame(const GameRecord& game) {
+    LoggedGame logged;
+    logged.startTime = game.startTime;
+    logged.start = game.opening.board;
+    logged.startSide = game.opening.sideToMove;
+    logged.moves = game.moves;
+    logged.result = game.result;
+    return logged;
+}
+
+// Portable Draughts Notation, numbering moves from the side that starts this game
+static string toPdn(const MatchSettings& settings, const GameRecord& game) {
+    const char* result = game.result > 0 ? "1-0" : game.result < 0 ? "0-1" : "1/2-1/2";
+    const string& white = settings.engines[game.engineAIsWhite ? 0 : 1].spec;
+    const string& black = settings.engines[game.engineAIsWhite ? 1 : 0].spec;
+    string pdn = "[Event \"checkers_match\"]\n[Round \"" + to_string(game.round + 1) + "\"]\n"
+               + "[White \"" + white + "\"]\n[Black \"" + black + "\"]\n"
+               + "[Result \"" + result + "\"]\n[Termination \"" + game.reason + "\"]\n"
+               + "[FEN \"" + toFen(game.opening.board, game.opening.sideToMove) + "\"]\n";
+    string line;
+    for (size_t i = 0; i < game.moves.size(); ++i) {
+        string token = (i % 2 == 0 ? to_string(i / 2 + 1) + ". " : "") + moveToString(game.moves[i].move);
+        if (line.size() + token.size() + 1 > 79) {
+            pdn += line + "\n";
+            line.clear();
+        }
+        line += (line.empty() ? "" : " ") + token;
+    }
+    if (line.size() + strlen(result) + 1 > 79) {
+        pdn += line + "\n";
+        line.clear();
+    }
+    pdn += line + (line.empty() ? "" : " ") + result + "\n\n";
+    return pdn;
+}
+
+// Training positions for checkers_tune: every position of the game, one
+// "<FEN> <result>" line each, labelled with the game's result for White
+static string toPositions(const GameRecord& game) {
+    const char* result = game.result > 0 ? "1-0" : game.result < 0 ? "0-1" : "1/2-1/2";
+    string lines;
+    Bitboard board = game.opening.board;
+    char sideToMove = game.opening.sideToMove;
+    for (const LoggedMove& move : game.moves) {
+        lines += toFen(board, sideToMove) + " " + result + "\n";
+        board = applyMove(board, move.move);
+        sideToMove = opponentOf(sideToMove);
+    }
+    return lines + toFen(board, sideToMove) + " " + result + "\n";
+}
+
+// Elo difference for a score fraction (clamped so a perfect score stays finite)
+static double eloFromScore(double score) {
+    score = min(max(score, 1e-3), 1.0 - 1e-3);
+    return -400.0 * log10(1.0 / score - 1.0);
+}
+
+// Elo of A over B and the half-width of its 95% confidence interval
+static void eloEstimate(int wins, int draws, int losses, double& elo, double& margin) {
+    int games = wins + draws + losses;
+    if (games == 0) {
+        elo = margin = 0.0;
+        return;
+    }
+    double score = (wins + 0.5 * draws) / games;
+    double variance = (wins * pow(1.0 - score, 2) + draws * pow(0.5 - score, 2) + losses * pow(score, 2)) / games;
+    double deviation = sqrt(variance / games);
+    elo = eloFromScore(score);
+    margin = (eloFromScore(score + 1.96 * deviation) - eloFromScore(score - 1.96 * deviation)) / 2.0;
+}
+
+static void printUsage(const char* program) {
+    printf("Usage: %s --a <engine> --b <engine> [options]\n"
+           "  <engine> is a comma-separated list of depth=<plies>, movetime=<ms>, man=<value>, king=<value>,\n"
+           "  advancement=<value>, backrank=<value>, center=<value>, runaway=<value>, mobility=<value>\n"
+           "  (evaluation weights in hundredths of a man), eval=<file> (weights from a file, see checkers_tune),\n"
+           "  quiescence=<0|1> (play out captures at the horizon, default 1),\n"
+           "  pvs=<0|1> (principal variation search with aspiration windows, default 1)\n"
+           "  --games <count>        Number of games, each opening played with both colours (default %d)\n"
+           "  --concurrency <count>  Games played at the same time (default: all hardware threads)\n"
+           "  --random-plies <plies> Random moves from the start position per opening (default %d)\n"
+           "  --openings <file>      Start positions, one FEN per line, instead of random openings\n"
+           "  --seed <number>        Seed for the random openings (default 1)\n"
+           "  --max-plies <plies>    Adjudicate a draw after this many plies (default %d)\n"
+           "  --hash <MB>            Transposition table size per engine and game (default %zu)\n"
+           "  --book <file>          Let both engines play from this opening book\n"
+           "  --tablebases <dir>     Let both engines use these endgame tables and adjudicate with them\n"
+           "  --pdn <file>           Append every finished game to this file (default: no game record)\n"
+           "  --positions <file>     Append every position of every game with the game's result, for checkers_tune\n"
+           "  --log <file>           Append every game with the search behind each move to this game log\n"
+           "  --help                 Show this help\n",
+           program, DEFAULT_MATCH_GAMES, DEFAULT_RANDOM_PLIES, DEFAULT_MAX_PLIES, DEFAULT_MATCH_HASH_MB);
+}
+
+int main(int argc, char* argv[]) {
+    MatchSettings settings;
+    int concurrency = max(1, (int)thread::hardware_concurrency());
+    string engineSpecs[2];
+    string openingsPath, bookPath, tablebaseDirectory, pdnPath, positionsPath, logPath;
+
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (option == "--help" || option == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if (!value) {
+            fprintf(stderr, "%s: unknown or incomplete option '%s'\n", argv[0], option.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+        else if (option == "--a") engineSpecs[0] = value;
+        else if (option == "--b") engineSpecs[1] = value;
+        else if (option == "--games") settings.games = max(1, atoi(value));
+        else if (option == "--concurrency") concurrency = max(1, atoi(value));
+        else if (option == "--random-plies") settings.randomPlies = max(0, atoi(value));
+        else if (option == "--openings") openingsPath = value;
+        else if (option == "--seed") settings.seed = (uint32_t)strtoul(value, nullptr, 10);
+        else if (option == "--max-plies") settings.maxPlies = max(1, atoi(value));
+        else if (option == "--hash") settings.hashMB = strtoul(value, nullptr, 10);
+        else if (option == "--book") bookPath = value;
+        else if (option == "--tablebases") tablebaseDirectory = value;
+        else if (option == "--pdn") pdnPath = value;
+        else if (option == "--positions") positionsPath = value;
+        else if (option == "--log") logPath = value;
+        else {
+            fprintf(stderr, "%s: unknown option '%s'\n", argv[0], option.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+        ++i;
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        if (engineSpecs[i].empty() || !parseEngineConfig(engineSpecs[i], settings.engines[i])) {
+            fprintf(stderr, "%s: --%c expects an engine like depth=9,king=300\n", argv[0], "ab"[i]);
+            return 2;
+        }
+    }
+    if (!openingsPath.empty() && !readOpenings(openingsPath, settings.openings)) {
+        fprintf(stderr, "%s: cannot read openings from '%s'\n", argv[0], openingsPath.c_str());
+        return 2;
+    }
+    if (!bookPath.empty() && !openingBook.load(bookPath)) {
+        fprintf(stderr, "%s: cannot read opening book '%s'\n", argv[0], bookPath.c_str());
+        return 2;
+    }
+    if (!tablebaseDirectory.empty() && tablebases.load(tablebaseDirectory) == 0) {
+        fprintf(stderr, "%s: no endgame tables found in '%s'\n", argv[0], tablebaseDirectory.c_str());
+    }
+    FILE* pdn = nullptr;
+    if (!pdnPath.empty() && !(pdn = fopen(pdnPath.c_str(), "a"))) {
+        fprintf(stderr, "%s: cannot open '%s'\n", argv[0], pdnPath.c_str());
+        return 2;
+    }
+    FILE* positions = nullptr;
+    if (!positionsPath.empty() && !(positions = fopen(positionsPath.c_str(), "a"))) {
+        fprintf(stderr, "%s: cannot open '%s'\n", argv[0], positionsPath.c_str());
+        return 2;
+    }
+    GameLogWriter gameLog;
+    if (!logPath.empty() && !gameLog.open(logPath)) {
+        fprintf(stderr, "%s: cannot open game log '%s'\n", argv[0], logPath.c_str());
+        return 2;
+    }
+
+    printf("A: %s\nB: %s\n%d games, %d at a time\n", settings.engines[0].spec.c_str(), settings.engines[1].spec.c_str(),
+           settings.games, concurrency);
+
+    atomic<int> nextRound{ 0 };
+    mutex resultsLock;
+    int wins = 0, draws = 0, losses = 0; // From A's point of view
+    int finished = 0;
+    MatchClock::time_point start = MatchClock::now();
+
+    auto worker = [&]() {
+        TranspositionTable tables[2];
+        for (auto& table : tables) table.resize(settings.hashMB);
+        for (int round = nextRound++; round < settings.games; round = nextRound++) {
+            GameRecord game = playGame(settings, round, tables);
+            int scoreForA = game.engineAIsWhite ? game.result : -game.result;
+
+            lock_guard<mutex> lock(resultsLock);
+            (scoreForA > 0 ? wins : scoreForA < 0 ? losses : draws)++;
+            ++finished;
+            if (pdn) {
+                fputs(toPdn(settings, game).c_str(), pdn);
+                fflush(pdn);
+            }
+            if (positions) fputs(toPositions(game).c_str(), positions);
+            if (gameLog.isOpen()) gameLog.writeGame(toLoggedGame(game));
+            double hours = chrono::duration<double>(MatchClock::now() - start).count() / 3600.0;
+            double elo, margin;
+            eloEstimate(wins, draws, losses, elo, margin);
+            printf("game %4d/%d  round %4d %-7s %-22s  A +%d =%d -%d  Elo %+.1f +/- %.1f  %.0f games/hour\n",
+                   finished, settings.games, game.round + 1,
+                   game.result > 0 ? "1-0" : game.result < 0 ? "0-1" : "1/2-1/2", game.reason,
+                   wins, draws, losses, elo, margin, finished / max(hours, 1e-9));
+            fflush(stdout);
+        }
+    };
+
+    vector<thread> workers;
+    for (int i = 1; i < concurrency; ++i) workers.emplace_back(worker);
+    worker();
+    for (auto& thread : workers) thread.join();
+    if (pdn) fclose(pdn);
+    if (positions) fclose(positions);
+
+    double seconds = chrono::duration<double>(MatchClock::now() - start).count();
+    double elo, margin;
+    eloEstimate(wins, draws, losses, elo, margin);
+    printf("final: A +%d =%d -%d (%.1f%%)  Elo difference %+.1f +/- %.1f (95%%)\n", wins, draws, losses,
+           100.0 * (wins + 0.5 * draws) / max(1, wins + draws + losses), elo, margin);
+    printf("%d games in %.1f s, %.0f games/hour\n", finished, seconds, finished / max(seconds / 3600.0, 1e-9));
+    if (openingBook.size() > 0) {
+        printf("book hits: %llu of %llu searches\n", (unsigned long long)openingBook.hitCount(), (unsigned long long)openingBook.probeCount());
+    }
+    return 0;
+}
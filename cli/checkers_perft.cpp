@@ -0,0 +1,184 @@
+// Perft: counts the leaf nodes of the legal move tree to verify generateLegalMoves
+// and applyMove, and to measure their throughput in nodes per second. --verify also
+// checks the incrementally updated hash and evaluation terms against a recompute.
+
+#include "board.h"
+#include "perft.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+using PerftClock = chrono::steady_clock;
+
+// A test position with its known node counts for depth 1, 2, 3, ...
+struct PerftPosition {
+    const char* name;
+    const char* fen;
+    vector<uint64_t> counts;
+};
+
+// Regression suite for --verify; update the counts only for intentional rule changes.
+// The start position counts are the published English checkers perft numbers.
+static const vector<PerftPosition> PERFT_SUITE = {
+    { "start", START_FEN,
+      { 7, 49, 302, 1469, 7361, 36768, 179740, 845931, 3963680 } },
+    { "kings and forced captures", "W:WK18,K22,25,30:BK7,10,14,15",
+      { 2, 9, 47, 200, 1274, 6534, 41183, 210929, 1287114 } },
+    { "middlegame, black to move", "B:W17,21,22,26,29,31:B5,6,9,10,13,K24",
+      { 7, 26, 102, 347, 1329, 4610, 17187, 63117, 238830 } },
+    { "crowded centre", "W:W14,19,23,24,27,28,30:B2,3,7,8,10,11,16",
+      { 1, 1, 6, 36, 193, 984, 4632, 21987, 93290 } },
+    { "king endgame, black to move", "B:WK1,K32:BK4,K29",
+      { 2, 8, 40, 200, 840, 4494, 25284, 141802, 722300 } },
+    { "king multi-jumps", "W:WK6,K32:B10,11,18,19,K26,27",
+      { 4, 17, 58, 292, 1397, 6740, 31321, 154159, 716648 } },
+    { "man triple jump", "W:W30:B26,18,10",
+      { 1, 0 } },
+};
+
+// Malformed FENs that parseFen must reject rather than accept or throw on
+static const vector<const char*> INVALID_FENS = {
+    "W:W99999999999:B1",
+    "W:W0:B1",
+    "W:W33:B1",
+    "W:W1,1:B2",
+    "W:W1:BK",
+    "X:W1:B2",
+    "W:W1:W2",
+};
+
+// Depth to which --verify compares the incremental state with a recompute at every node
+const int INCREMENTAL_CHECK_DEPTH = 6;
+
+static double secondsSince(PerftClock::time_point start) {
+    return chrono::duration<double>(PerftClock::now() - start).count();
+}
+
+static void printUsage(const char* program) {
+    printf("Usage: %s [options]\n"
+           "  --fen <FEN>      Position to count from (default: start position)\n"
+           "  --depth <plies>  Count depth 1 through this depth (default 8)\n"
+           "  --divide         Print the count below each root move at --depth\n"
+           "  --verify         Run the built-in positions and check their known counts and incremental state\n"
+           "  --help           Show this help\n",
+           program);
+}
+
+// Check every suite position against its known counts; returns false on any mismatch
+static bool runVerify() {
+    bool passed = true;
+    uint64_t totalNodes = 0;
+    double totalSeconds = 0.0;
+
+    for (const auto& position : PERFT_SUITE) {
+        Bitboard board;
+        char sideToMove;
+        if (!parseFen(position.fen, board, sideToMove)) {
+            printf("FAIL %-28s invalid FEN\n", position.name);
+            passed = false;
+            continue;
+        }
+        bool positionPassed = true;
+        for (size_t depth = 1; depth <= position.counts.size(); ++depth) {
+            PerftClock::time_point start = PerftClock::now();
+            uint64_t nodes = perft(board, sideToMove, (int)depth);
+            totalSeconds += secondsSince(start);
+            totalNodes += nodes;
+            if (nodes != position.counts[depth - 1]) {
+                printf("FAIL %-28s depth %zu: got %llu, expected %llu\n", position.name, depth,
+                       (unsigned long long)nodes, (unsigned long long)position.counts[depth - 1]);
+                positionPassed = false;
+            }
+        }
+
+        // The incremental state is checked to a smaller depth: every node is recomputed from scratch
+        int checkDepth = min((int)position.counts.size(), INCREMENTAL_CHECK_DEPTH);
+        uint64_t mismatches;
+        uint64_t checked = checkIncrementalState(board, sideToMove, checkDepth, mismatches);
+        if (mismatches > 0) {
+            printf("FAIL %-28s incremental hash or evaluation terms differ at %llu of %llu nodes\n", position.name,
+                   (unsigned long long)mismatches, (unsigned long long)checked);
+            positionPassed = false;
+        }
+        passed = passed && positionPassed;
+        printf("%s %-28s depth 1-%zu\n", positionPassed ? "ok  " : "FAIL", position.name, position.counts.size());
+    }
+
+    bool rejected = true;
+    for (const char* fen : INVALID_FENS) {
+        Bitboard board;
+        char sideToMove;
+        if (parseFen(fen, board, sideToMove)) {
+            printf("FAIL invalid FEN accepted: %s\n", fen);
+            rejected = false;
+        }
+    }
+    passed = passed && rejected;
+    printf("%s %zu invalid FENs rejected\n", rejected ? "ok  " : "FAIL", INVALID_FENS.size());
+
+    printf("%llu nodes in %.3f s, %.0f nodes/s\n", (unsigned long long)totalNodes, totalSeconds,
+           totalNodes / max(totalSeconds, 1e-9));
+    printf(passed ? "all perft counts match\n" : "PERFT MISMATCH\n");
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    string fen = START_FEN;
+    int depth = 8;
+    bool divide = false;
+    bool verify = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--help" || option == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if (option == "--divide") divide = true;
+        else if (option == "--verify") verify = true;
+        else if (option == "--fen" && i + 1 < argc) fen = argv[++i];
+        else if (option == "--depth" && i + 1 < argc) depth = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "%s: unknown or incomplete option '%s'\n", argv[0], option.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (verify) return runVerify() ? 0 : 1;
+
+    Bitboard board;
+    char sideToMove;
+    if (!parseFen(fen, board, sideToMove) || depth < 1) {
+        fprintf(stderr, "%s: invalid FEN or depth\n", argv[0]);
+        return 2;
+    }
+
+    if (divide) {
+        PerftClock::time_point start = PerftClock::now();
+        uint64_t total = 0;
+        for (const auto& move : generateLegalMoves(board, sideToMove)) {
+            uint64_t nodes = perft(applyMove(board, move), opponentOf(sideToMove), depth - 1);
+            printf("%s: %llu\n", moveToString(move).c_str(), (unsigned long long)nodes);
+            total += nodes;
+        }
+        double seconds = secondsSince(start);
+        printf("total %llu nodes in %.3f s, %.0f nodes/s\n", (unsigned long long)total, seconds, total / max(seconds, 1e-9));
+        return 0;
+    }
+
+    printf("%-6s %14s %10s %14s\n", "depth", "nodes", "seconds", "nps");
+    for (int d = 1; d <= depth; ++d) {
+        PerftClock::time_point start = PerftClock::now();
+        uint64_t nodes = perft(board, sideToMove, d);
+        double seconds = secondsSince(start);
+        printf("%-6d %14llu %10.3f %14.0f\n", d, (unsigned long long)nodes, seconds, nodes / max(seconds, 1e-9));
+    }
+    return 0;
+}
@@ -0,0 +1,384 @@
+// Analysis server: a long-lived engine process driven by a line protocol (in the
+// spirit of UCI) over stdin/stdout or a Unix domain socket. The transposition table
+// stays warm between requests, so consecutive analyses of related positions are cheap.
+//
+// Commands, one per line; scores are from White's point of view:
+//   position startpos|fen <FEN> [moves <move> ...]  Set the position (moves as "22-18", "22x15")
+//   go [depth <plies>] [movetime <ms>] [threads <count>] [infinite]   (threads at most MAX_SEARCH_THREADS)
+//       Search in the background, printing "info ..." after every iteration and
+//       "bestmove <move> score <score> depth <depth>" at the end
+//   stop                Stop the running search (it still prints its bestmove)
+//   hash                Table size and usage, and the stored entry for the position
+//   stats               Statistics of the last finished search as "stats <JSON>"
+//   clearhash           Empty the transposition table
+//   sethash <MB>        Resize (and empty) the transposition table
+//   show                Print the position as a FEN
+//   isready             Answered with "readyok"
+//   quit                End the session (in socket mode the server waits for the next client)
+// Malformed commands are answered with "error <reason>".
+
+#include "board.h"
+#include "opening_book.h"
+#include "search.h"
+#include "tablebase.h"
+#include "transposition_table.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CHECKERS_UNIX_SOCKETS 1
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// One connection: commands come in on `in`, replies go out on `out`. The search
+// thread writes too, so every line is written whole under a lock.
+class Channel {
+public:
+    Channel(FILE* in, FILE* out) : in(in), out(out) {}
+
+    // Next line without its line ending; false at the end of the input
+    bool readLine(string& line) {
+        line.clear();
+        for (int c = fgetc(in); c != EOF; c = fgetc(in)) {
+            if (c == '\n') return true;
+            if (c != '\r') line += (char)c;
+        }
+        return !line.empty();
+    }
+
+    void writeLine(const string& line) {
+        lock_guard<mutex> lock(writeLock);
+        fputs(line.c_str(), out);
+        fputc('\n', out);
+        fflush(out);
+    }
+
+private:
+    FILE* in;
+    FILE* out;
+    mutex writeLock;
+};
+
+// The legal move a table entry's best move stands for (the table only keeps start
+// and end squares); null if there is none
+static const BitMove* storedMove(const vector<BitMove>& moves, const TTEntry& entry) {
+    if (!entry.hasMove) return nullptr;
+    for (const BitMove& move : moves) {
+        if (move.from == entry.bestMove.from && move.to == entry.bestMove.to) return &move;
+    }
+    return nullptr;
+}
+
+// Best line found so far, read back from the transposition table: follow the stored
+// best moves from the position while they are legal (and do not repeat a position)
+static string principalVariation(Bitboard board, char sideToMove, int maxLength) {
+    string line;
+    unordered_set<uint64_t> seen;
+    for (int ply = 0; ply < maxLength && seen.insert(board.hash).second; ++ply) {
+        TTEntry entry;
+        if (!transpositionTable.probe(board.hash, entry)) break;
+        vector<BitMove> moves = generateLegalMoves(board, sideToMove);
+        const BitMove* next = storedMove(moves, entry);
+        if (!next) break;
+        line += (line.empty() ? "" : " ") + moveToString(*next);
+        board = applyMove(board, *next);
+        sideToMove = opponentOf(sideToMove);
+    }
+    return line;
+}
+
+// State of one client session; the search runs on its own thread
+class Session {
+public:
+    Session(Channel& channel, int defaultThreads, const EvalWeights& weights)
+        : channel(channel), defaultThreads(defaultThreads), weights(weights) {
+        parseFen(START_FEN, board, sideToMove);
+    }
+
+    ~Session() {
+        stopSearch();
+    }
+
+    // Handle lines until "quit" or the end of the input
+    void run() {
+        string line;
+        while (channel.readLine(line)) {
+            istringstream words(line);
+            string command;
+            if (!(words >> command)) continue;
+            if (command == "quit") break;
+            handle(command, words);
+        }
+    }
+
+private:
+    Channel& channel;
+    int defaultThreads;
+    EvalWeights weights;
+    Bitboard board;
+    char sideToMove;
+    thread searcher;
+    atomic<bool> cancel{ false };
+    atomic<bool> searching{ false };
+    SearchResult lastResult = {}; // Written by the search thread, read only while no search runs
+
+    void handle(const string& command, istringstream& words) {
+        if (command == "isready") channel.writeLine("readyok");
+        else if (command == "stop") stopSearch();
+        else if (command == "show") channel.writeLine("position " + toFen(board, sideToMove));
+        else if (command == "hash") reportHash();
+        else if (searching.load()) channel.writeLine("error busy: send stop first");
+        else if (command == "stats") channel.writeLine("stats " + searchStatsJson(lastResult));
+        else if (command == "position") setPosition(words);
+        else if (command == "go") startSearch(words);
+        else if (command == "clearhash") transpositionTable.clear();
+        else if (command == "sethash") {
+            size_t sizeMB;
+            if (!(words >> sizeMB)) channel.writeLine("error sethash expects a size in MB");
+            else transpositionTable.resize(sizeMB);
+        }
+        else channel.writeLine("error unknown command '" + command + "'");
+    }
+
+    // position startpos|fen <FEN> [moves <move> ...]; the position is unchanged on error
+    void setPosition(istringstream& words) {
+        string kind, fen;
+        words >> kind;
+        if (kind == "startpos") fen = START_FEN;
+        else if (kind == "fen") words >> fen;
+        Bitboard next;
+        char nextSide;
+        if (fen.empty() || !parseFen(fen, next, nextSide)) {
+            channel.writeLine("error position expects startpos or fen <FEN>");
+            return;
+        }
+        string word;
+        if (words >> word && word != "moves") {
+            channel.writeLine("error unexpected '" + word + "' after the position");
+            return;
+        }
+        while (words >> word) {
+            const BitMove* played = nullptr;
+            vector<BitMove> moves = generateLegalMoves(next, nextSide);
+            for (const BitMove& move : moves) {
+                if (moveToString(move) == word) {
+                    played = &move;
+                    break;
+                }
+            }
+            if (!played) {
+                channel.writeLine("error illegal move '" + word + "'");
+                return;
+            }
+            next = applyMove(next, *played);
+            nextSide = opponentOf(nextSide);
+        }
+        board = next;
+        sideToMove = nextSide;
+    }
+
+    // go [depth <plies>] [movetime <ms>] [threads <count>] [infinite]
+    void startSearch(istringstream& words) {
+        SearchOptions options;
+        options.threads = defaultThreads;
+        options.weights = weights;
+        bool hasDepth = false;
+        string word;
+        while (words >> word) {
+            long value = 0;
+            bool needsValue = word == "depth" || word == "movetime" || word == "threads";
+            if (needsValue && !(words >> value && value > 0)) {
+                channel.writeLine("error " + word + " expects a positive number");
+                return;
+            }
+            if (word == "depth") { options.maxDepth = (int)min<long>(value, MAX_SEARCH_DEPTH); hasDepth = true; }
+            else if (word == "movetime") options.timeLimitMs = (int)value;
+            else if (word == "threads") {
+                if (value > MAX_SEARCH_THREADS) {
+                    channel.writeLine("error threads out of range (at most " + to_string(MAX_SEARCH_THREADS) + ")");
+                    return;
+                }
+                options.threads = (int)value;
+            }
+            else if (word == "infinite") { options.maxDepth = MAX_SEARCH_DEPTH; hasDepth = true; }
+            else {
+                channel.writeLine("error unknown go option '" + word + "'");
+                return;
+            }
+        }
+        // With only a time budget the search deepens as far as the clock allows
+        if (!hasDepth && options.timeLimitMs > 0) options.maxDepth = MAX_SEARCH_DEPTH;
+
+        Bitboard position = board;
+        char side = sideToMove;
+        options.cancel = &cancel;
+        options.onIteration = [this, position, side](const SearchResult& progress) {
+            char info[160];
+            snprintf(info, sizeof(info), "info depth %d score %d nodes %llu qnodes %llu nps %.0f time %.3f",
+                     progress.depth, progress.score, (unsigned long long)progress.nodes,
+                     (unsigned long long)progress.quiescenceNodes, progress.nodes / max(progress.seconds, 1e-9), progress.seconds);
+            channel.writeLine(string(info) + " pv " + principalVariation(position, side, progress.depth + 1));
+        };
+
+        if (searcher.joinable()) searcher.join();
+        cancel.store(false);
+        searching.store(true);
+        searcher = thread([this, position, side, options]() {
+            SearchResult result = findBestMove(position, side, options);
+            lastResult = result;
+            searching.store(false); // A client may answer the bestmove line with the next go at once
+            if (!result.hasMove) channel.writeLine("bestmove none");
+            else {
+                channel.writeLine("bestmove " + moveToString(result.bestMove) + " score " + to_string(result.score)
+                                  + " depth " + to_string(result.depth) + (result.fromBook ? " book" : ""));
+            }
+        });
+    }
+
+    // Wait for the running search (if any) to stop and print its bestmove
+    void stopSearch() {
+        cancel.store(true);
+        if (searcher.joinable()) searcher.join();
+    }
+
+    void reportHash() {
+        channel.writeLine("hash size " + to_string(transpositionTable.sizeBytes() / (1024 * 1024)) + " MB used "
+                          + to_string(transpositionTable.usagePermille()) + " permille");
+        TTEntry entry;
+        if (!transpositionTable.probe(board.hash, entry)) {
+            channel.writeLine("hash entry none");
+            return;
+        }
+        const char* bound = entry.bound == BOUND_EXACT ? "exact" : entry.bound == BOUND_LOWER ? "lower" : "upper";
+        // The table keeps the side to move's score; report it from White's side like everything else
+        int score = sideToMove == WHITE ? entry.score : -entry.score;
+        vector<BitMove> moves = generateLegalMoves(board, sideToMove);
+        const BitMove* move = storedMove(moves, entry);
+        channel.writeLine("hash entry depth " + to_string(entry.depth) + " bound " + bound + " score " + to_string(score)
+                          + " move " + (move ? moveToString(*move) : "none"));
+    }
+};
+
+#ifdef CHECKERS_UNIX_SOCKETS
+// Serve clients on a Unix domain socket one after another; returns only on error
+static int serveSocket(const char* program, const string& path, int threads, const EvalWeights& weights) {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        fprintf(stderr, "%s: socket path '%s' is too long\n", program, path.c_str());
+        return 2;
+    }
+    path.copy(address.sun_path, path.size());
+
+    // Replace a socket left behind by an earlier run, but never any other file
+    struct stat existing;
+    if (stat(path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) unlink(path.c_str());
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 || bind(listener, (const sockaddr*)&address, sizeof(address)) != 0 || listen(listener, 4) != 0) {
+        perror(program);
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN); // A client that hangs up must not end the server
+    fprintf(stderr, "listening on %s\n", path.c_str());
+
+    for (;;) {
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0) continue;
+        FILE* in = fdopen(client, "r");
+        FILE* out = fdopen(dup(client), "w");
+        if (in && out) {
+            Channel channel(in, out);
+            Session session(channel, threads, weights);
+            session.run();
+        }
+        if (in) fclose(in);
+        else close(client);
+        if (out) fclose(out);
+    }
+}
+#endif
+
+static void printUsage(const char* program) {
+    printf("Usage: %s [options]\n"
+           "  --socket <path>    Listen on this Unix domain socket instead of using stdin/stdout\n"
+           "  --threads <count>  Search threads when go does not say (default 1)\n"
+           "  --hash <MB>        Transposition table size in megabytes (default %zu)\n"
+           "  --tablebases <dir> Probe the endgame tables built by checkers_tbgen in this directory\n"
+           "  --book <file>      Play from the opening book built by checkers_book\n"
+           "  --eval <file>      Evaluation weights written by checkers_tune\n"
+           "  --help             Show this help\n"
+           "See the comment at the top of checkers_server.cpp or the README for the protocol.\n",
+           program, DEFAULT_HASH_MB);
+}
+
+int main(int argc, char* argv[]) {
+    string socketPath;
+    int threads = 1;
+    size_t hashMB = DEFAULT_HASH_MB;
+    string tablebaseDirectory;
+    string bookPath;
+    string evalPath;
+
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--help" || option == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if (option == "--socket" && i + 1 < argc) socketPath = argv[++i];
+        else if (option == "--threads" && i + 1 < argc) threads = clamp(atoi(argv[++i]), 1, MAX_SEARCH_THREADS);
+        else if (option == "--hash" && i + 1 < argc) hashMB = strtoul(argv[++i], nullptr, 10);
+        else if (option == "--tablebases" && i + 1 < argc) tablebaseDirectory = argv[++i];
+        else if (option == "--book" && i + 1 < argc) bookPath = argv[++i];
+        else if (option == "--eval" && i + 1 < argc) evalPath = argv[++i];
+        else {
+            fprintf(stderr, "%s: unknown or incomplete option '%s'\n", argv[0], option.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    transpositionTable.resize(hashMB);
+    if (!tablebaseDirectory.empty() && tablebases.load(tablebaseDirectory) == 0) {
+        fprintf(stderr, "%s: no endgame tables found in '%s'\n", argv[0], tablebaseDirectory.c_str());
+    }
+    if (!bookPath.empty() && !openingBook.load(bookPath)) {
+        fprintf(stderr, "%s: cannot read opening book '%s'\n", argv[0], bookPath.c_str());
+        return 2;
+    }
+    EvalWeights weights;
+    if (!evalPath.empty() && !loadEvalWeights(evalPath, weights)) {
+        fprintf(stderr, "%s: cannot read evaluation weights '%s'\n", argv[0], evalPath.c_str());
+        return 2;
+    }
+
+    if (!socketPath.empty()) {
+#ifdef CHECKERS_UNIX_SOCKETS
+        return serveSocket(argv[0], socketPath, threads, weights);
+#else
+        fprintf(stderr, "%s: Unix domain sockets are not available on this platform\n", argv[0]);
+        return 2;
+#endif
+    }
+
+    Channel channel(stdin, stdout);
+    Session session(channel, threads, weights);
+    session.run();
+    return 0;
+}
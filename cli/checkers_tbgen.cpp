@@ -0,0 +1,99 @@
+// Endgame tablebase generator: builds the win/loss/draw tables (with distance to
+// the end of the game) that the search probes, and looks up single positions.
+
+#include "board.h"
+#include "tablebase.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+const char* DEFAULT_TABLEBASE_DIRECTORY = "tablebases";
+const int DEFAULT_TABLEBASE_PIECES = 6;
+
+static void printUsage(const char* program) {
+    printf("Usage: %s [options]\n"
+           "  --dir <path>       Table directory (default \"%s\")\n"
+           "  --pieces <count>   Build every table with up to this many pieces (default %d, at most %d)\n"
+           "  --threads <count>  Generator threads (default: all hardware threads)\n"
+           "  --probe <FEN>      Look up one position in the tables instead of building them\n"
+           "  --help             Show this help\n"
+           "Tables already in the directory are kept, so an interrupted run can simply be restarted.\n",
+           program, DEFAULT_TABLEBASE_DIRECTORY, DEFAULT_TABLEBASE_PIECES, MAX_TABLEBASE_PIECES);
+}
+
+static void printTable(const TablebaseProgress& progress) {
+    const Material& m = progress.material;
+    if (progress.resumed) {
+        printf("%-10s %13llu positions  already built\n", tablebaseFileName(m).c_str(), (unsigned long long)progress.positions);
+    }
+    else {
+        printf("%-10s %13llu positions  %11llu wins %11llu losses  longest %3d plies  %3d passes %9.1f s\n",
+               tablebaseFileName(m).c_str(), (unsigned long long)progress.positions, (unsigned long long)progress.wins,
+               (unsigned long long)progress.losses, progress.longestPlies, progress.passes, progress.seconds);
+    }
+    fflush(stdout);
+}
+
+static int probePosition(const string& directory, const string& fen) {
+    Bitboard board;
+    char sideToMove;
+    if (!parseFen(fen, board, sideToMove)) {
+        fprintf(stderr, "invalid FEN '%s'\n", fen.c_str());
+        return 2;
+    }
+    tablebases.load(directory);
+    TablebaseOutcome outcome;
+    int plies;
+    if (!tablebases.probe(board, sideToMove, outcome, plies)) {
+        printf("not in tables\n");
+        return 1;
+    }
+    const char* result = outcome == TB_WIN ? "win" : outcome == TB_LOSS ? "loss" : "draw";
+    if (outcome == TB_DRAW) printf("%s\n", result);
+    else printf("%s in %d plies\n", result, plies);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    string directory = DEFAULT_TABLEBASE_DIRECTORY;
+    int pieces = DEFAULT_TABLEBASE_PIECES;
+    int threads = max(1, (int)thread::hardware_concurrency());
+    string probeFen;
+
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--help" || option == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if (option == "--dir" && i + 1 < argc) directory = argv[++i];
+        else if (option == "--pieces" && i + 1 < argc) pieces = atoi(argv[++i]);
+        else if (option == "--threads" && i + 1 < argc) threads = max(1, atoi(argv[++i]));
+        else if (option == "--probe" && i + 1 < argc) probeFen = argv[++i];
+        else {
+            fprintf(stderr, "%s: unknown or incomplete option '%s'\n", argv[0], option.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (!probeFen.empty()) return probePosition(directory, probeFen);
+
+    if (pieces < 2 || pieces > MAX_TABLEBASE_PIECES) {
+        fprintf(stderr, "%s: --pieces must be between 2 and %d\n", argv[0], MAX_TABLEBASE_PIECES);
+        return 2;
+    }
+
+    printf("building tables with up to %d pieces in %s using %d threads\n", pieces, directory.c_str(), threads);
+    string error;
+    if (!generateTablebases(directory, pieces, threads, printTable, error)) {
+        fprintf(stderr, "%s: %s\n", argv[0], error.c_str());
+        return 1;
+    }
+    printf("done\n");
+    return 0;
+}
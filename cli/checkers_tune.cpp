@@ -0,0 +1,346 @@
+// Evaluation tuner: fits the evaluation weights to game results by Texel-style
+// logistic regression. Every training position is "<FEN> <result>" (as written by
+// checkers_match --positions); the tuner minimises the mean squared difference
+// between the result and a sigmoid of the static evaluation, with full-batch Adam.
+// The data is streamed in chunks and parsed by all threads; the parsed samples are
+// kept in memory between epochs only if they fit in --memory, otherwise every epoch
+// reads the file again, so the memory used stays bounded however large the data.
+
+#include "board.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+const int DEFAULT_TUNE_EPOCHS = 500;
+const size_t DEFAULT_CHUNK_POSITIONS = 1 << 20;
+const size_t DEFAULT_MEMORY_MB = 512;
+const double DEFAULT_LEARNING_RATE = 1.0; // Adam step, in hundredths of a man
+const char* DEFAULT_WEIGHTS_PATH = "tuned.eval";
+
+// Weights the tuner fits; TERM_MEN stays fixed and sets the scale of the others
+const char* const TERM_NAMES[EVAL_TERM_COUNT] = { "man", "king", "advancement", "backrank", "center", "runaway", "mobility" };
+
+// One training position: its complete evaluation terms and the game's result for White
+struct Sample {
+    EvalTerms terms;
+    float result; // 1 White won, 0.5 draw, 0 Black won
+};
+
+// Run body(begin, end) over [0, count) split into one contiguous slice per thread
+static void parallelFor(int threads, size_t count, const function<void(int, size_t, size_t)>& body) {
+    vector<thread> workers;
+    size_t slice = (count + threads - 1) / threads;
+    for (int t = 0; t < threads; ++t) {
+        size_t begin = min(count, t * slice);
+        size_t end = min(count, begin + slice);
+        workers.emplace_back(body, t, begin, end);
+    }
+    for (auto& worker : workers) worker.join();
+}
+
+// "1-0", "0-1", "1/2-1/2" or a number from 0 to 1; false for anything else
+static bool parseResult(const char* text, float& result) {
+    if (strcmp(text, "1-0") == 0) result = 1.0f;
+    else if (strcmp(text, "0-1") == 0) result = 0.0f;
+    else if (strcmp(text, "1/2-1/2") == 0) result = 0.5f;
+    else {
+        char* end = nullptr;
+        result = strtof(text, &end);
+        if (end == text || *end != '\0' || result < 0.0f || result > 1.0f) return false;
+    }
+    return true;
+}
+
+// The training data, read one chunk of lines at a time
+class SampleSource {
+public:
+    SampleSource(const string& path, size_t chunkPositions, size_t memoryBytes, int threads)
+        : path(path), chunkPositions(max<size_t>(1, chunkPositions)), memoryBytes(memoryBytes), threads(threads) {}
+
+    // Hand every sample to visit(samples, count), a chunk at a time; false if the file cannot be read
+    bool forEachChunk(const function<void(const Sample*, size_t)>& visit) {
+        if (cached) {
+            for (size_t i = 0; i < cache.size(); i += chunkPositions) visit(&cache[i], min(chunkPositions, cache.size() - i));
+            return true;
+        }
+        FILE* file = fopen(path.c_str(), "r");
+        if (!file) return false;
+        bool firstPass = lines == 0;
+        bool keep = firstPass;
+        vector<string> chunk;
+        vector<Sample> samples;
+        vector<char> usable;
+        char buffer[256];
+        for (;;) {
+            chunk.clear();
+            while (chunk.size() < chunkPositions && fgets(buffer, sizeof(buffer), file)) {
+                size_t length = strcspn(buffer, "\r\n");
+                buffer[length] = '\0';
+                if (length > 0 && buffer[0] != '#') chunk.push_back(buffer);
+            }
+            if (chunk.empty()) break;
+            parseChunk(chunk, samples, usable);
+
+            // Keep only the usable samples, in file order
+            size_t kept = 0;
+            for (size_t i = 0; i < chunk.size(); ++i) {
+                if (usable[i]) samples[kept++] = samples[i];
+            }
+            if (firstPass) {
+                lines += chunk.size();
+                unusable += chunk.size() - kept;
+                quiet += kept;
+            }
+            visit(samples.data(), kept);
+
+            if (keep && (cache.size() + kept) * sizeof(Sample) <= memoryBytes) cache.insert(cache.end(), samples.begin(), samples.begin() + kept);
+            else if (keep) {
+                keep = false; // Too large to cache: later epochs read the file again
+                vector<Sample>().swap(cache);
+            }
+        }
+        fclose(file);
+        cached = keep;
+        return true;
+    }
+
+    uint64_t lines = 0;    // Non-comment lines in the file (counted on the first pass)
+    uint64_t quiet = 0;    // Used as samples
+    uint64_t unusable = 0; // Malformed, or with a capture pending (the static evaluation misjudges those)
+    bool cached = false;   // All samples are in memory
+
+private:
+    string path;
+    size_t chunkPositions;
+    size_t memoryBytes;
+    int threads;
+    vector<Sample> cache;
+
+    // Parse the lines on all threads; usable[i] says whether samples[i] holds a quiet position
+    void parseChunk(const vector<string>& chunk, vector<Sample>& samples, vector<char>& usable) {
+        samples.resize(chunk.size());
+        usable.assign(chunk.size(), 0);
+        parallelFor(threads, chunk.size(), [&](int, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const string& line = chunk[i];
+                size_t space = line.find_last_of(' ');
+                if (space == string::npos) continue;
+                Bitboard board;
+                char sideToMove;
+                if (!parseFen(line.substr(0, space), board, sideToMove)) continue;
+                if (!parseResult(line.c_str() + space + 1, samples[i].result)) continue;
+                if (hasCapture(board, sideToMove)) continue;
+                samples[i].terms = board.terms;
+                addPositionalTerms(board, samples[i].terms);
+                usable[i] = 1;
+            }
+        });
+    }
+};
+
+// Samples evaluated so far, over all passes (for the throughput report)
+static uint64_t samplesProcessed = 0;
+
+// Expected result for White of an evaluation (in hundredths of a man)
+static inline double sigmoid(double evaluation, double k) {
+    return 1.0 / (1.0 + pow(10.0, -k * evaluation / 400.0));
+}
+
+// Mean squared error of the weights over all samples; stores its gradient in `gradient` if given
+static double meanError(SampleSource& source, const double weights[EVAL_TERM_COUNT], double k, int threads,
+                        double gradient[EVAL_TERM_COUNT]) {
+    double totalError = 0.0;
+    double totalGradient[EVAL_TERM_COUNT] = {};
+    uint64_t count = 0;
+    vector<double> errors(threads);
+    vector<array<double, EVAL_TERM_COUNT>> gradients(threads);
+    source.forEachChunk([&](const Sample* samples, size_t size) {
+        parallelFor(threads, size, [&](int t, size_t begin, size_t end) {
+            double error = 0.0;
+            array<double, EVAL_TERM_COUNT> slope = {};
+            for (size_t i = begin; i < end; ++i) {
+                double evaluation = 0.0;
+                for (int term = 0; term < EVAL_TERM_COUNT; ++term) evaluation += weights[term] * samples[i].terms[term];
+                double expected = sigmoid(evaluation, k);
+                double difference = expected - samples[i].result;
+                error += difference * difference;
+                if (gradient) {
+                    double scale = 2.0 * difference * expected * (1.0 - expected) * k * log(10.0) / 400.0;
+                    for (int term = 0; term < EVAL_TERM_COUNT; ++term) slope[term] += scale * samples[i].terms[term];
+                }
+            }
+            errors[t] = error;
+            gradients[t] = slope;
+        });
+        for (int t = 0; t < threads; ++t) {
+            totalError += errors[t];
+            for (int term = 0; term < EVAL_TERM_COUNT; ++term) totalGradient[term] += gradients[t][term];
+        }
+        count += size;
+    });
+    samplesProcessed += count;
+    if (count == 0) return 0.0;
+    if (gradient) {
+        for (int term = 0; term < EVAL_TERM_COUNT; ++term) gradient[term] = totalGradient[term] / count;
+    }
+    return totalError / count;
+}
+
+// The sigmoid scale that best fits the starting weights (golden-section search)
+static double fitScale(SampleSource& source, const double weights[EVAL_TERM_COUNT], int threads) {
+    const double ratio = (sqrt(5.0) - 1.0) / 2.0;
+    double low = 0.05, high = 5.0;
+    double a = high - ratio * (high - low), b = low + ratio * (high - low);
+    double errorA = meanError(source, weights, a, threads, nullptr);
+    double errorB = meanError(source, weights, b, threads, nullptr);
+    for (int i = 0; i < 30; ++i) {
+        if (errorA < errorB) {
+            high = b;
+            b = a;
+            errorB = errorA;
+            a = high - ratio * (high - low);
+            errorA = meanError(source, weights, a, threads, nullptr);
+        }
+        else {
+            low = a;
+            a = b;
+            errorA = errorB;
+            b = low + ratio * (high - low);
+            errorB = meanError(source, weights, b, threads, nullptr);
+        }
+    }
+    return (low + high) / 2.0;
+}
+
+static EvalWeights roundedWeights(const double weights[EVAL_TERM_COUNT]) {
+    EvalWeights rounded;
+    for (int term = 0; term < EVAL_TERM_COUNT; ++term) setEvalWeight(rounded, TERM_NAMES[term], (int)lround(weights[term]));
+    return rounded;
+}
+
+static void printWeights(const double weights[EVAL_TERM_COUNT]) {
+    for (int term = 0; term < EVAL_TERM_COUNT; ++term) printf(" %s %.1f", TERM_NAMES[term], weights[term]);
+    printf("\n");
+}
+
+static void printUsage(const char* program) {
+    printf("Usage: %s --data <file> [options]\n"
+           "  --data <file>      Training positions, one \"<FEN> <result>\" per line (checkers_match --positions)\n"
+           "  --eval <file>      Starting weights (default: the built-in weights)\n"
+           "  --out <file>       Weight file to write (default \"%s\")\n"
+           "  --epochs <count>   Passes over the data (default %d)\n"
+           "  --rate <step>      Adam learning rate in hundredths of a man (default %.1f)\n"
+           "  --scale <k>        Sigmoid scale; fitted to the starting weights when not given\n"
+           "  --threads <count>  Worker threads (default: all hardware threads)\n"
+           "  --chunk <count>    Positions read and parsed at a time (default %zu)\n"
+           "  --memory <MB>      Keep the parsed data in memory between epochs up to this size (default %zu)\n"
+           "  --help             Show this help\n",
+           program, DEFAULT_WEIGHTS_PATH, DEFAULT_TUNE_EPOCHS, DEFAULT_LEARNING_RATE, DEFAULT_CHUNK_POSITIONS, DEFAULT_MEMORY_MB);
+}
+
+int main(int argc, char* argv[]) {
+    string dataPath, evalPath, outPath = DEFAULT_WEIGHTS_PATH;
+    int epochs = DEFAULT_TUNE_EPOCHS;
+    double rate = DEFAULT_LEARNING_RATE;
+    double k = 0.0;
+    int threads = max(1, (int)thread::hardware_concurrency());
+    size_t chunkPositions = DEFAULT_CHUNK_POSITIONS;
+    size_t memoryMB = DEFAULT_MEMORY_MB;
+
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (option == "--help" || option == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if (!value) {
+            fprintf(stderr, "%s: unknown or incomplete option '%s'\n", argv[0], option.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+        else if (option == "--data") dataPath = value;
+        else if (option == "--eval") evalPath = value;
+        else if (option == "--out") outPath = value;
+        else if (option == "--epochs") epochs = max(0, atoi(value));
+        else if (option == "--rate") rate = atof(value);
+        else if (option == "--scale") k = atof(value);
+        else if (option == "--threads") threads = max(1, atoi(value));
+        else if (option == "--chunk") chunkPositions = strtoul(value, nullptr, 10);
+        else if (option == "--memory") memoryMB = strtoul(value, nullptr, 10);
+        else {
+            fprintf(stderr, "%s: unknown option '%s'\n", argv[0], option.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+        ++i;
+    }
+    if (dataPath.empty()) {
+        fprintf(stderr, "%s: --data is required\n", argv[0]);
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    EvalWeights start;
+    if (!evalPath.empty() && !loadEvalWeights(evalPath, start)) {
+        fprintf(stderr, "%s: cannot read weights from '%s'\n", argv[0], evalPath.c_str());
+        return 2;
+    }
+    double weights[EVAL_TERM_COUNT] = { (double)start.man, (double)start.king, (double)start.advancement, (double)start.backRank,
+                                        (double)start.center, (double)start.runaway, (double)start.mobility };
+
+    auto clockStart = chrono::steady_clock::now();
+    SampleSource source(dataPath, chunkPositions, memoryMB * 1024 * 1024, threads);
+    double error = meanError(source, weights, k > 0.0 ? k : 1.0, threads, nullptr);
+    if (source.lines == 0) {
+        fprintf(stderr, "%s: no positions read from '%s'\n", argv[0], dataPath.c_str());
+        return 2;
+    }
+    printf("%llu positions, %llu quiet ones used (%s)\n", (unsigned long long)source.lines, (unsigned long long)source.quiet,
+           source.cached ? "kept in memory" : "streamed every epoch");
+    if (k <= 0.0) k = fitScale(source, weights, threads);
+    error = meanError(source, weights, k, threads, nullptr);
+    printf("scale %.4f, starting error %.6f\n", k, error);
+
+    // Adam, on every weight but the men's
+    double first[EVAL_TERM_COUNT] = {}, second[EVAL_TERM_COUNT] = {};
+    const double beta1 = 0.9, beta2 = 0.999, epsilon = 1e-12;
+    for (int epoch = 1; epoch <= epochs; ++epoch) {
+        double gradient[EVAL_TERM_COUNT];
+        error = meanError(source, weights, k, threads, gradient);
+        for (int term = TERM_KINGS; term < EVAL_TERM_COUNT; ++term) {
+            first[term] = beta1 * first[term] + (1.0 - beta1) * gradient[term];
+            second[term] = beta2 * second[term] + (1.0 - beta2) * gradient[term] * gradient[term];
+            double corrected = first[term] / (1.0 - pow(beta1, epoch));
+            double scale = sqrt(second[term] / (1.0 - pow(beta2, epoch))) + epsilon;
+            weights[term] -= rate * corrected / scale;
+        }
+        if (epoch % 50 == 0 || epoch == epochs) {
+            printf("epoch %4d error %.6f ", epoch, error);
+            printWeights(weights);
+            fflush(stdout);
+        }
+    }
+
+    EvalWeights tuned = roundedWeights(weights);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - clockStart).count();
+    printf("final error %.6f, %.1f s (%.0f positions/s)\n", meanError(source, weights, k, threads, nullptr), seconds,
+           samplesProcessed / max(seconds, 1e-9));
+    if (!saveEvalWeights(outPath, tuned)) {
+        fprintf(stderr, "%s: cannot write '%s'\n", argv[0], outPath.c_str());
+        return 1;
+    }
+    printf("wrote %s\n", outPath.c_str());
+    return 0;
+}
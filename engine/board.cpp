@@ -0,0 +1,818 @@
+#include "board.h"
+
+#include <bit> // popcount / countr_zero for bitboards
+#include <cmath> // Required for abs()
+#include <fstream>
+#include <sstream>
+
+// x86 builds with GCC or Clang get vector evaluation kernels, selected at runtime
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CHECKERS_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Function to initialize a standard Checkers starting board
+CheckersBoard initializeBoard() {
+    CheckersBoard board(8, vector<char>(8, EMPTY_SQUARE));
+
+    // Place Black pieces
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            if ((i + j) % 2 != 0) { // Only place on dark squares
+                board[i][j] = BLACK_PIECE;
+            }
+        }
+    }
+
+    // Place White pieces
+    for (int i = 5; i < 8; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            if ((i + j) % 2 != 0) { // Only place on dark squares
+                board[i][j] = WHITE_PIECE;
+            }
+        }
+    }
+
+    return board;
+}
+
+// Helper function to check if a square is on the board and is a dark square
+bool isValidSquare(int row, int col) {
+    return row >= 0 && row < 8 && col >= 0 && col < 8 && (row + col) % 2 != 0;
+}
+
+// Simplified function to check if a move is valid (basic movement and capture)
+// This does NOT fully implement all Checkers rules (e.g., mandatory multi-jumps)
+bool isValidMove(const CheckersBoard& board, const Move& move, char currentPlayer) {
+    // Check if start and end squares are valid dark squares
+    if (!isValidSquare(move.startRow, move.startCol) || !isValidSquare(move.endRow, move.endCol)) {
+        return false;
+    }
+
+    char piece = board[move.startRow][move.startCol];
+    char targetPiece = board[move.endRow][move.endCol];
+
+    // Check if the piece belongs to the current player
+    bool isCurrentPlayerPiece = false;
+    if (currentPlayer == WHITE) {
+        if (piece == WHITE_PIECE || piece == WHITE_KING) isCurrentPlayerPiece = true;
+    }
+    else { // Black player
+        if (piece == BLACK_PIECE || piece == BLACK_KING) isCurrentPlayerPiece = true;
+    }
+    if (!isCurrentPlayerPiece) return false;
+
+    // Cannot move to a non-empty square
+    if (targetPiece != EMPTY_SQUARE) return false;
+
+    int rowDiff = move.endRow - move.startRow;
+    int colDiff = move.endCol - move.startCol;
+
+    // --- Basic Movement and Capture Logic (Simplified) ---
+
+    // Regular piece movement (one step diagonally forward)
+    if (piece == WHITE_PIECE) {
+        if (rowDiff == -1 && abs(colDiff) == 1) return true;
+    }
+    else if (piece == BLACK_PIECE) {
+        if (rowDiff == 1 && abs(colDiff) == 1) return true;
+    }
+
+    // King movement (one step diagonally in any direction)
+    if (piece == WHITE_KING || piece == BLACK_KING) {
+        if (abs(rowDiff) == 1 && abs(colDiff) == 1) return true;
+    }
+
+    // Basic Capture (jumping over one opponent piece); men only capture forward
+    bool isMan = piece == WHITE_PIECE || piece == BLACK_PIECE;
+    bool isForward = (piece == WHITE_PIECE && rowDiff < 0) || (piece == BLACK_PIECE && rowDiff > 0);
+    if (abs(rowDiff) == 2 && abs(colDiff) == 2 && (!isMan || isForward)) {
+        int jumpedRow = move.startRow + rowDiff / 2;
+        int jumpedCol = move.startCol + colDiff / 2;
+
+        if (isValidSquare(jumpedRow, jumpedCol)) {
+            char jumpedPiece = board[jumpedRow][jumpedCol];
+            // Check if the jumped piece is an opponent's piece
+            if (currentPlayer == WHITE) {
+                if (jumpedPiece == BLACK_PIECE || jumpedPiece == BLACK_KING) return true;
+            }
+            else { // Black player
+                if (jumpedPiece == WHITE_PIECE || jumpedPiece == WHITE_KING) return true;
+            }
+        }
+    }
+
+    // If none of the above, the move is not valid in this simplified model
+    return false;
+}
+
+// --- Zobrist Hashing ---
+
+// Piece kinds used to index the Zobrist key table
+enum ZobristPiece { Z_WHITE_MAN, Z_WHITE_KING, Z_BLACK_MAN, Z_BLACK_KING };
+
+struct ZobristKeys {
+    uint64_t pieces[4][32];
+    uint64_t blackToMove; // Toggled on every move
+};
+
+// Fixed-seed splitmix64 so hashes are identical from run to run
+constexpr ZobristKeys makeZobristKeys() {
+    ZobristKeys keys = {};
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    auto next = [&state]() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    };
+    for (auto& pieceKeys : keys.pieces) {
+        for (auto& key : pieceKeys) key = next();
+    }
+    keys.blackToMove = next();
+    return keys;
+}
+
+constexpr ZobristKeys ZOBRIST = makeZobristKeys();
+
+// Zobrist key of the piece standing on a square
+static inline uint64_t pieceKey(const Bitboard& board, int square) {
+    bool isKing = (board.kings >> square) & 1u;
+    if ((board.white >> square) & 1u) return ZOBRIST.pieces[isKing ? Z_WHITE_KING : Z_WHITE_MAN][square];
+    return ZOBRIST.pieces[isKing ? Z_BLACK_KING : Z_BLACK_MAN][square];
+}
+
+// Compute a position's key from scratch (applyMove keeps it up to date afterwards)
+uint64_t computeHash(const Bitboard& board, char sideToMove) {
+    uint64_t hash = sideToMove == BLACK ? ZOBRIST.blackToMove : 0;
+    for (uint32_t pieces = board.white | board.black; pieces; pieces &= pieces - 1) {
+        hash ^= pieceKey(board, countr_zero(pieces));
+    }
+    return hash;
+}
+
+// Bitboard rows on which men are crowned
+const uint32_t WHITE_PROMOTION_ROW = 0x0000000Fu; // Row 0
+const uint32_t BLACK_PROMOTION_ROW = 0xF0000000u; // Row 7
+
+// --- Move Tables ---
+
+// Diagonal directions, in the order the generator tries them (which is also ascending
+// order of the target square): the first two go up the board, the last two down
+enum Direction { UP_LEFT, UP_RIGHT, DOWN_LEFT, DOWN_RIGHT, DIRECTION_COUNT };
+
+// How a piece moves: men only forward (White up, Black down), kings both ways
+enum MoverKind { WHITE_MAN_MOVER, BLACK_MAN_MOVER, KING_MOVER, MOVER_KINDS };
+
+// Geometry of the 32 playable squares, computed at compile time so that move
+// generation only looks squares up. -1 marks a step or jump off the board.
+struct MoveTables {
+    int8_t jumpOver[32][DIRECTION_COUNT]; // Square a capture jumps over (-1 if it cannot land)
+    int8_t jumpTo[32][DIRECTION_COUNT];   // Square the capture lands on
+    uint32_t steps[MOVER_KINDS][32];       // Squares each kind of piece can step to
+    int firstDirection[MOVER_KINDS];       // Directions [first, end) each kind moves and captures in
+    int endDirection[MOVER_KINDS];
+    uint32_t promotion[MOVER_KINDS];       // Squares on which the piece is crowned (none for kings)
+};
+
+constexpr MoveTables makeMoveTables() {
+    MoveTables tables = {};
+    tables.firstDirection[WHITE_MAN_MOVER] = UP_LEFT;
+    tables.endDirection[WHITE_MAN_MOVER] = DOWN_LEFT;
+    tables.firstDirection[BLACK_MAN_MOVER] = DOWN_LEFT;
+    tables.endDirection[BLACK_MAN_MOVER] = DIRECTION_COUNT;
+    tables.firstDirection[KING_MOVER] = UP_LEFT;
+    tables.endDirection[KING_MOVER] = DIRECTION_COUNT;
+    tables.promotion[WHITE_MAN_MOVER] = WHITE_PROMOTION_ROW;
+    tables.promotion[BLACK_MAN_MOVER] = BLACK_PROMOTION_ROW;
+
+    for (int square = 0; square < 32; ++square) {
+        for (int direction = 0; direction < DIRECTION_COUNT; ++direction) {
+            int rowDir = direction < DOWN_LEFT ? -1 : 1;
+            int colDir = direction % 2 == 0 ? -1 : 1;
+            int over = neighborSquare(square, rowDir, colDir);
+            int to = over < 0 ? -1 : neighborSquare(over, rowDir, colDir);
+            tables.jumpOver[square][direction] = (int8_t)(to < 0 ? -1 : over);
+            tables.jumpTo[square][direction] = (int8_t)to;
+            for (int kind = 0; kind < MOVER_KINDS; ++kind) {
+                bool moves = direction >= tables.firstDirection[kind] && direction < tables.endDirection[kind];
+                if (moves && over >= 0) tables.steps[kind][square] |= 1u << over;
+            }
+        }
+    }
+    return tables;
+}
+
+constexpr MoveTables MOVE_TABLES = makeMoveTables();
+
+static_assert(MOVE_TABLES.steps[WHITE_MAN_MOVER][4] == 1u, "square 4 is on the edge and steps up to square 0 only");
+static_assert(MOVE_TABLES.jumpTo[9][UP_LEFT] == 0 && MOVE_TABLES.jumpOver[9][UP_LEFT] == 5, "9 jumps over 5 to 0");
+
+// Which table row a piece uses
+static inline MoverKind moverKind(bool isKing, bool isWhite) {
+    return isKing ? KING_MOVER : (isWhite ? WHITE_MAN_MOVER : BLACK_MAN_MOVER);
+}
+
+// --- Incremental Evaluation Terms ---
+
+// The two middle squares of rows 2 to 5
+const uint32_t CENTER_SQUARES = (1u << 9) | (1u << 10) | (1u << 13) | (1u << 14) | (1u << 17) | (1u << 18) | (1u << 21) | (1u << 22);
+
+// What one piece adds to the White-minus-Black terms, by [ZobristPiece][square]
+constexpr auto makeEvalContributions() {
+    std::array<std::array<EvalTerms, 32>, 4> contributions = {};
+    for (int square = 0; square < 32; ++square) {
+        int row = square / 4;
+        int16_t center = (CENTER_SQUARES >> square) & 1u;
+        EvalTerms& whiteMan = contributions[Z_WHITE_MAN][square];
+        whiteMan[TERM_MEN] = 1;
+        whiteMan[TERM_ADVANCEMENT] = (int16_t)(7 - row); // White men start at the bottom
+        whiteMan[TERM_BACK_RANK] = row == 7;
+        whiteMan[TERM_CENTER] = center;
+        EvalTerms& blackMan = contributions[Z_BLACK_MAN][square];
+        blackMan[TERM_MEN] = -1;
+        blackMan[TERM_ADVANCEMENT] = (int16_t)-row;
+        blackMan[TERM_BACK_RANK] = -(row == 0);
+        blackMan[TERM_CENTER] = (int16_t)-center;
+        contributions[Z_WHITE_KING][square][TERM_KINGS] = 1;
+        contributions[Z_WHITE_KING][square][TERM_CENTER] = center;
+        contributions[Z_BLACK_KING][square][TERM_KINGS] = -1;
+        contributions[Z_BLACK_KING][square][TERM_CENTER] = (int16_t)-center;
+    }
+    return contributions;
+}
+
+constexpr auto EVAL_CONTRIBUTIONS = makeEvalContributions();
+
+// Contribution of the piece standing on a square
+static inline const EvalTerms& pieceTerms(const Bitboard& board, int square) {
+    bool isKing = (board.kings >> square) & 1u;
+    if ((board.white >> square) & 1u) return EVAL_CONTRIBUTIONS[isKing ? Z_WHITE_KING : Z_WHITE_MAN][square];
+    return EVAL_CONTRIBUTIONS[isKing ? Z_BLACK_KING : Z_BLACK_MAN][square];
+}
+
+static inline void addTerms(EvalTerms& terms, const EvalTerms& piece) {
+    for (int term = 0; term < INCREMENTAL_TERM_COUNT; ++term) terms[term] += piece[term];
+}
+
+static inline void subtractTerms(EvalTerms& terms, const EvalTerms& piece) {
+    for (int term = 0; term < INCREMENTAL_TERM_COUNT; ++term) terms[term] -= piece[term];
+}
+
+EvalTerms computeEvalTerms(const Bitboard& board) {
+    EvalTerms terms = {};
+    for (uint32_t pieces = board.white | board.black; pieces; pieces &= pieces - 1) {
+        addTerms(terms, pieceTerms(board, countr_zero(pieces)));
+    }
+    return terms;
+}
+
+// Take the moving and captured pieces out, then put the mover on its new square (possibly crowned)
+EvalTerms evalTermsAfterMove(const Bitboard& board, const BitMove& move) {
+    EvalTerms terms = board.terms;
+    subtractTerms(terms, pieceTerms(board, move.from));
+    for (uint32_t captured = move.captured; captured; captured &= captured - 1) {
+        subtractTerms(terms, pieceTerms(board, countr_zero(captured)));
+    }
+    bool isWhite = (board.white >> move.from) & 1u;
+    bool crowned = ((board.kings >> move.from) & 1u) || ((1u << move.to) & (isWhite ? WHITE_PROMOTION_ROW : BLACK_PROMOTION_ROW));
+    ZobristPiece piece = isWhite ? (crowned ? Z_WHITE_KING : Z_WHITE_MAN) : (crowned ? Z_BLACK_KING : Z_BLACK_MAN);
+    addTerms(terms, EVAL_CONTRIBUTIONS[piece][move.to]);
+    return terms;
+}
+
+// Build a bitboard from the GUI's 8x8 representation
+Bitboard toBitboard(const CheckersBoard& board, char sideToMove) {
+    Bitboard bitboard = { 0, 0, 0, 0 };
+    for (int square = 0; square < 32; ++square) {
+        uint32_t bit = 1u << square;
+        char piece = board[squareRow(square)][squareCol(square)];
+        if (piece == WHITE_PIECE || piece == WHITE_KING) bitboard.white |= bit;
+        if (piece == BLACK_PIECE || piece == BLACK_KING) bitboard.black |= bit;
+        if (piece == WHITE_KING || piece == BLACK_KING) bitboard.kings |= bit;
+    }
+    bitboard.hash = computeHash(bitboard, sideToMove);
+    bitboard.terms = computeEvalTerms(bitboard);
+    return bitboard;
+}
+
+// Expand a bitboard back into the GUI's 8x8 representation
+CheckersBoard toCheckersBoard(const Bitboard& bitboard) {
+    CheckersBoard board(8, vector<char>(8, EMPTY_SQUARE));
+    for (int square = 0; square < 32; ++square) {
+        uint32_t bit = 1u << square;
+        bool isKing = (bitboard.kings & bit) != 0;
+        char& target = board[squareRow(square)][squareCol(square)];
+        if (bitboard.white & bit) target = isKing ? WHITE_KING : WHITE_PIECE;
+        else if (bitboard.black & bit) target = isKing ? BLACK_KING : BLACK_PIECE;
+    }
+    return board;
+}
+
+// Expand a bitboard move into the GUI's Move structure
+Move toMove(const BitMove& bitMove) {
+    Move move = { squareRow(bitMove.from), squareCol(bitMove.from),
+                  squareRow(bitMove.to), squareCol(bitMove.to),
+                  bitMove.captured != 0, {} };
+    for (uint32_t captured = bitMove.captured; captured; captured &= captured - 1) {
+        int square = countr_zero(captured);
+        move.capturedPieces.push_back({ squareRow(square), squareCol(square) });
+    }
+    return move;
+}
+
+// State of one capture sequence being extended by addCaptureChains
+struct CaptureChain {
+    int from;           // Square the capturing piece started on
+    MoverKind kind;     // Directions it captures in, and where it would be crowned
+    uint32_t opponent;  // Opponent pieces, including ones already jumped
+    uint32_t empty;     // Empty squares, including the start square once the piece has left
+};
+
+// Extend a capture sequence from `square`, having already captured `captured`.
+// Each maximal sequence becomes one move: a piece must keep jumping while it can,
+// cannot jump the same piece twice, and a man's turn ends when it is crowned.
+template <class Moves>
+static void addCaptureChains(const CaptureChain& chain, int square, uint32_t captured, Moves& captureMoves) {
+    bool extended = false;
+
+    // Men can only capture forward
+    for (int direction = MOVE_TABLES.firstDirection[chain.kind]; direction < MOVE_TABLES.endDirection[chain.kind]; ++direction) {
+        int over = MOVE_TABLES.jumpOver[square][direction];
+        if (over < 0) continue;
+        uint32_t overBit = 1u << over;
+        int to = MOVE_TABLES.jumpTo[square][direction];
+        if (!(chain.opponent & overBit & ~captured) || !((chain.empty >> to) & 1u)) continue;
+
+        extended = true;
+        if ((MOVE_TABLES.promotion[chain.kind] >> to) & 1u) {
+            captureMoves.push_back({ (uint8_t)chain.from, (uint8_t)to, captured | overBit });
+        }
+        else {
+            addCaptureChains(chain, to, captured | overBit, captureMoves);
+        }
+    }
+
+    if (!extended && captured) {
+        // A king can reach the same end square over the same pieces by different paths
+        BitMove move = { (uint8_t)chain.from, (uint8_t)square, captured };
+        for (const auto& existing : captureMoves) {
+            if (sameMove(existing, move)) return;
+        }
+        captureMoves.push_back(move);
+    }
+}
+
+bool hasCapture(const Bitboard& board, char currentPlayer) {
+    uint32_t own = currentPlayer == WHITE ? board.white : board.black;
+    uint32_t opponent = currentPlayer == WHITE ? board.black : board.white;
+    uint32_t empty = ~(board.white | board.black);
+    bool isWhite = currentPlayer == WHITE;
+
+    for (uint32_t pieces = own; pieces; pieces &= pieces - 1) {
+        int from = countr_zero(pieces);
+        MoverKind kind = moverKind((board.kings >> from) & 1u, isWhite);
+        for (int direction = MOVE_TABLES.firstDirection[kind]; direction < MOVE_TABLES.endDirection[kind]; ++direction) {
+            int over = MOVE_TABLES.jumpOver[from][direction];
+            if (over >= 0 && ((opponent >> over) & 1u) && ((empty >> MOVE_TABLES.jumpTo[from][direction]) & 1u)) return true;
+        }
+    }
+    return false;
+}
+
+// Function to generate all legal moves for the current player on a bitboard
+// Captures are mandatory and each capture move is a complete multi-jump sequence.
+// Fills `moves` (a vector or a MoveList) in place so callers can reuse its storage.
+template <class Moves>
+static void fillLegalMoves(const Bitboard& board, char currentPlayer, Moves& moves) {
+    moves.clear();
+
+    uint32_t own = currentPlayer == WHITE ? board.white : board.black;
+    uint32_t opponent = currentPlayer == WHITE ? board.black : board.white;
+    uint32_t occupied = board.white | board.black;
+    bool isWhite = currentPlayer == WHITE;
+
+    // Only look for capture chains if some piece can start one
+    if (hasCapture(board, currentPlayer)) {
+        for (uint32_t pieces = own; pieces; pieces &= pieces - 1) {
+            int from = countr_zero(pieces);
+            CaptureChain chain = { from, moverKind((board.kings >> from) & 1u, isWhite), opponent, ~occupied | (1u << from) };
+            addCaptureChains(chain, from, 0, moves);
+        }
+
+        // In Checkers, captures are mandatory. If capture moves exist, only return those.
+        return;
+    }
+
+    // Simple moves: the empty squares among the piece's steps, in ascending order
+    for (uint32_t pieces = own; pieces; pieces &= pieces - 1) {
+        int from = countr_zero(pieces);
+        uint32_t targets = MOVE_TABLES.steps[moverKind((board.kings >> from) & 1u, isWhite)][from] & ~occupied;
+        for (; targets; targets &= targets - 1) {
+            moves.push_back({ (uint8_t)from, (uint8_t)countr_zero(targets), 0 });
+        }
+    }
+}
+
+void generateLegalMoves(const Bitboard& board, char currentPlayer, vector<BitMove>& moves) {
+    fillLegalMoves(board, currentPlayer, moves);
+}
+
+void generateLegalMoves(const Bitboard& board, char currentPlayer, MoveList& moves) {
+    fillLegalMoves(board, currentPlayer, moves);
+}
+
+vector<BitMove> generateLegalMoves(const Bitboard& board, char currentPlayer) {
+    vector<BitMove> moves;
+    generateLegalMoves(board, currentPlayer, moves);
+    return moves;
+}
+
+// Function to make a move in place, recording what unmakeMove needs to take it back
+void makeMove(Bitboard& board, const BitMove& move, UndoRecord& undo) {
+    uint32_t fromBit = 1u << move.from;
+    uint32_t toBit = 1u << move.to;
+    bool isWhite = (board.white & fromBit) != 0;
+    bool isKing = (board.kings & fromBit) != 0;
+    uint64_t oldHash = board.hash;
+
+    undo.move = move;
+    undo.capturedKings = move.captured & board.kings;
+    undo.promoted = !isKing && (toBit & (isWhite ? WHITE_PROMOTION_ROW : BLACK_PROMOTION_ROW));
+    undo.terms = board.terms;
+    board.terms = evalTermsAfterMove(board, move);
+
+    // Take the moving and captured pieces out of the hash, and pass the turn
+    board.hash ^= pieceKey(board, move.from) ^ ZOBRIST.blackToMove;
+    for (uint32_t captured = move.captured; captured; captured &= captured - 1) {
+        board.hash ^= pieceKey(board, countr_zero(captured));
+    }
+
+    // Move the piece (and its king flag) and remove captured pieces
+    // (a king's capture sequence can end on the square it started from)
+    uint32_t& own = isWhite ? board.white : board.black;
+    uint32_t& opponent = isWhite ? board.black : board.white;
+    own = (own & ~fromBit) | toBit;
+    opponent &= ~move.captured;
+    board.kings &= ~(move.captured | fromBit);
+
+    // Promote to King if a piece reaches the opposite end
+    if (isKing || undo.promoted) board.kings |= toBit;
+
+    // Put the piece back into the hash on its new square (possibly crowned)
+    board.hash ^= pieceKey(board, move.to);
+    undo.hashDelta = board.hash ^ oldHash;
+}
+
+// Function to take back a move made with makeMove
+void unmakeMove(Bitboard& board, const UndoRecord& undo) {
+    uint32_t fromBit = 1u << undo.move.from;
+    uint32_t toBit = 1u << undo.move.to;
+    bool isWhite = (board.white & toBit) != 0;
+    bool wasKing = (board.kings & toBit) && !undo.promoted;
+
+    uint32_t& own = isWhite ? board.white : board.black;
+    uint32_t& opponent = isWhite ? board.black : board.white;
+    own = (own & ~toBit) | fromBit;
+    opponent |= undo.move.captured;
+    board.kings = (board.kings & ~toBit) | undo.capturedKings | (wasKing ? fromBit : 0);
+    board.hash ^= undo.hashDelta;
+    board.terms = undo.terms;
+}
+
+// Function to apply a move to a bitboard
+Bitboard applyMove(const Bitboard& board, const BitMove& move) {
+    Bitboard newBoard = board;
+    UndoRecord undo;
+    makeMove(newBoard, move, undo);
+    return newBoard;
+}
+
+// --- Positional Terms ---
+
+// Squares in front of a man that an opposing piece would have to stand on to stop
+// it from running through to be crowned: the triangle widening by one column per row
+constexpr auto makeRunawayCones() {
+    std::array<std::array<uint32_t, 32>, 2> cones = {}; // [0] White men (moving up), [1] Black men
+    for (int square = 0; square < 32; ++square) {
+        for (int other = 0; other < 32; ++other) {
+            int rows = squareRow(square) - squareRow(other);
+            int columns = squareCol(square) - squareCol(other);
+            columns = columns < 0 ? -columns : columns;
+            if (rows > 0 && columns <= rows) cones[0][square] |= 1u << other;
+            if (rows < 0 && columns <= -rows) cones[1][square] |= 1u << other;
+        }
+    }
+    return cones;
+}
+
+constexpr auto RUNAWAY_CONES = makeRunawayCones();
+
+// Runaway men and simple moves of one side
+static void sidePositionalTerms(const Bitboard& board, bool isWhite, int& runaways, int& mobility) {
+    uint32_t own = isWhite ? board.white : board.black;
+    uint32_t opponent = isWhite ? board.black : board.white;
+    uint32_t empty = ~(board.white | board.black);
+    runaways = 0;
+    mobility = 0;
+    for (uint32_t pieces = own; pieces; pieces &= pieces - 1) {
+        int square = countr_zero(pieces);
+        bool isKing = (board.kings >> square) & 1u;
+        mobility += popcount(MOVE_TABLES.steps[moverKind(isKing, isWhite)][square] & empty);
+        if (!isKing && !(RUNAWAY_CONES[isWhite ? 0 : 1][square] & opponent)) ++runaways;
+    }
+}
+
+void addPositionalTerms(const Bitboard& board, EvalTerms& terms) {
+    int whiteRunaways, whiteMobility, blackRunaways, blackMobility;
+    sidePositionalTerms(board, true, whiteRunaways, whiteMobility);
+    sidePositionalTerms(board, false, blackRunaways, blackMobility);
+    terms[TERM_RUNAWAYS] = (int16_t)(whiteRunaways - blackRunaways);
+    terms[TERM_MOBILITY] = (int16_t)(whiteMobility - blackMobility);
+}
+
+
+// --- Evaluation Weights ---
+
+bool setEvalWeight(EvalWeights& weights, const string& name, int value) {
+    if (name == "man") weights.man = value;
+    else if (name == "king") weights.king = value;
+    else if (name == "advancement") weights.advancement = value;
+    else if (name == "backrank") weights.backRank = value;
+    else if (name == "center") weights.center = value;
+    else if (name == "runaway") weights.runaway = value;
+    else if (name == "mobility") weights.mobility = value;
+    else return false;
+    return true;
+}
+
+bool loadEvalWeights(const string& path, EvalWeights& weights) {
+    ifstream file(path);
+    if (!file) return false;
+    EvalWeights loaded = weights;
+    string line;
+    while (getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        istringstream words(line);
+        string name, extra;
+        int value;
+        if (!(words >> name)) continue; // Blank or comment
+        if (!(words >> value) || (words >> extra) || !setEvalWeight(loaded, name, value)) return false;
+    }
+    weights = loaded;
+    return true;
+}
+
+bool saveEvalWeights(const string& path, const EvalWeights& weights) {
+    ofstream file(path);
+    file << "# Evaluation weights in hundredths of a man\n"
+         << "man " << weights.man << "\n"
+         << "king " << weights.king << "\n"
+         << "advancement " << weights.advancement << "\n"
+         << "backrank " << weights.backRank << "\n"
+         << "center " << weights.center << "\n"
+         << "runaway " << weights.runaway << "\n"
+         << "mobility " << weights.mobility << "\n";
+    file.close();
+    return !file.fail();
+}
+
+// The weights in EvalTerm order
+static void weightValues(const EvalWeights& weights, int values[EVAL_TERM_COUNT]) {
+    const int ordered[EVAL_TERM_COUNT] = { weights.man, weights.king, weights.advancement, weights.backRank,
+                                           weights.center, weights.runaway, weights.mobility };
+    for (int term = 0; term < EVAL_TERM_COUNT; ++term) values[term] = ordered[term];
+}
+
+int evaluateTerms(const EvalTerms& terms, const EvalWeights& weights) {
+    int values[EVAL_TERM_COUNT];
+    weightValues(weights, values);
+    int score = 0;
+    for (int term = 0; term < EVAL_TERM_COUNT; ++term) score += values[term] * terms[term];
+    return score;
+}
+
+// Bitboard evaluation: the weighted sum of the terms makeMove keeps up to date
+// Positive value favors White (AI), negative favors Black (Human)
+int evaluateBoard(const Bitboard& board, const EvalWeights& weights) {
+    if (!usesPositionalTerms(weights)) {
+        const EvalTerms& terms = board.terms;
+        return weights.man * terms[TERM_MEN]
+             + weights.king * terms[TERM_KINGS]
+             + weights.advancement * terms[TERM_ADVANCEMENT]
+             + weights.backRank * terms[TERM_BACK_RANK]
+             + weights.center * terms[TERM_CENTER];
+    }
+    EvalTerms terms = board.terms;
+    addPositionalTerms(board, terms);
+    return evaluateTerms(terms, weights);
+}
+
+int evaluateBoard(const Bitboard& board) {
+    return evaluateBoard(board, EvalWeights());
+}
+
+// --- Batched Evaluation ---
+//
+// Every kernel computes the same dot product of the eight 16-bit term lanes with
+// the weights (multiply-add into 32-bit sums), so all of them agree exactly.
+
+using EvaluationKernel = void (*)(const EvalTerms* terms, size_t count, const int16_t* weights, int* scores);
+
+static void evaluateBoardsScalar(const EvalTerms* terms, size_t count, const int16_t* weights, int* scores) {
+    for (size_t i = 0; i < count; ++i) {
+        int score = 0;
+        for (int term = 0; term < EVAL_TERM_COUNT; ++term) score += weights[term] * terms[i][term];
+        scores[i] = score;
+    }
+}
+
+#ifdef CHECKERS_X86_KERNELS
+static_assert(sizeof(EvalTerms) == 16, "the vector kernels load one position per 128 bits");
+
+// Four positions per step: one multiply-add per position, then a 4x4 transpose to sum the pairs
+__attribute__((target("sse2")))
+static void evaluateBoardsSse2(const EvalTerms* terms, size_t count, const int16_t* weights, int* scores) {
+    __m128i weightLanes = _mm_loadu_si128((const __m128i*)weights);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i p0 = _mm_madd_epi16(_mm_loadu_si128((const __m128i*)&terms[i]), weightLanes);
+        __m128i p1 = _mm_madd_epi16(_mm_loadu_si128((const __m128i*)&terms[i + 1]), weightLanes);
+        __m128i p2 = _mm_madd_epi16(_mm_loadu_si128((const __m128i*)&terms[i + 2]), weightLanes);
+        __m128i p3 = _mm_madd_epi16(_mm_loadu_si128((const __m128i*)&terms[i + 3]), weightLanes);
+        __m128i sums01 = _mm_add_epi32(_mm_unpacklo_epi32(p0, p1), _mm_unpackhi_epi32(p0, p1));
+        __m128i sums23 = _mm_add_epi32(_mm_unpacklo_epi32(p2, p3), _mm_unpackhi_epi32(p2, p3));
+        __m128i sums = _mm_add_epi32(_mm_unpacklo_epi64(sums01, sums23), _mm_unpackhi_epi64(sums01, sums23));
+        _mm_storeu_si128((__m128i*)&scores[i], sums);
+    }
+    evaluateBoardsScalar(terms + i, count - i, weights, scores + i);
+}
+
+// Four positions per step, two per 256-bit register; two horizontal adds reduce each position
+__attribute__((target("avx2")))
+static void evaluateBoardsAvx2(const EvalTerms* terms, size_t count, const int16_t* weights, int* scores) {
+    __m256i weightLanes = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)weights));
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i p01 = _mm256_madd_epi16(_mm256_loadu_si256((const __m256i*)&terms[i]), weightLanes);
+        __m256i p23 = _mm256_madd_epi16(_mm256_loadu_si256((const __m256i*)&terms[i + 2]), weightLanes);
+        __m256i sums = _mm256_hadd_epi32(p01, p23);
+        sums = _mm256_hadd_epi32(sums, sums); // Lanes: i, i+2, i, i+2 | i+1, i+3, i+1, i+3
+        sums = _mm256_permutevar8x32_epi32(sums, order);
+        _mm_storeu_si128((__m128i*)&scores[i], _mm256_castsi256_si128(sums));
+    }
+    evaluateBoardsScalar(terms + i, count - i, weights, scores + i);
+}
+#endif
+
+struct EvaluationKernelChoice {
+    EvaluationKernel kernel;
+    const char* name;
+};
+
+static EvaluationKernelChoice chooseEvaluationKernel() {
+#ifdef CHECKERS_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return { evaluateBoardsAvx2, "avx2" };
+    if (__builtin_cpu_supports("sse2")) return { evaluateBoardsSse2, "sse2" };
+#endif
+    return { evaluateBoardsScalar, "scalar" };
+}
+
+static const EvaluationKernelChoice EVALUATION_KERNEL = chooseEvaluationKernel();
+
+void evaluateBoards(const EvalTerms* terms, size_t count, const EvalWeights& weights, int* scores) {
+    int values[EVAL_TERM_COUNT];
+    weightValues(weights, values);
+    int16_t weightLanes[EVAL_TERM_LANES] = {};
+    bool fitsLanes = true;
+    for (int term = 0; term < EVAL_TERM_COUNT; ++term) {
+        fitsLanes = fitsLanes && values[term] >= INT16_MIN && values[term] <= INT16_MAX;
+        weightLanes[term] = (int16_t)values[term];
+    }
+    if (!fitsLanes) { // Weights too large for 16-bit lanes
+        for (size_t i = 0; i < count; ++i) scores[i] = evaluateTerms(terms[i], weights);
+        return;
+    }
+    EVALUATION_KERNEL.kernel(terms, count, weightLanes, scores);
+}
+
+const char* evaluationKernelName() {
+    return EVALUATION_KERNEL.name;
+}
+
+// 8x8 wrappers used by the GUI; they convert at the edge and call the bitboard engine
+
+// Function to generate all possible legal moves for the current player (simplified)
+vector<Move> generateLegalMoves(const CheckersBoard& board, char currentPlayer) {
+    vector<Move> legalMoves;
+    for (const auto& bitMove : generateLegalMoves(toBitboard(board), currentPlayer)) {
+        legalMoves.push_back(toMove(bitMove));
+    }
+    return legalMoves;
+}
+
+// Simplified evaluation function (based on piece count and king count)
+// Positive value favors White (AI), negative favors Black (Human)
+int evaluateBoard(const CheckersBoard& board) {
+    return evaluateBoard(toBitboard(board));
+}
+
+// Function to apply a move to the board
+CheckersBoard applyMove(const CheckersBoard& board, const Move& move) {
+    CheckersBoard newBoard = board;
+    char movedPiece = newBoard[move.startRow][move.startCol];
+
+    // Move the piece (clearing first, as a capture sequence may end where it started)
+    newBoard[move.startRow][move.startCol] = EMPTY_SQUARE;
+    newBoard[move.endRow][move.endCol] = movedPiece;
+
+    // Remove captured pieces
+    for (const auto& captured : move.capturedPieces) {
+        newBoard[captured.first][captured.second] = EMPTY_SQUARE;
+    }
+
+    // Promote to King if a piece reaches the opposite end
+    if (movedPiece == WHITE_PIECE && move.endRow == 0) {
+        newBoard[move.endRow][move.endCol] = WHITE_KING;
+    }
+    else if (movedPiece == BLACK_PIECE && move.endRow == 7) {
+        newBoard[move.endRow][move.endCol] = BLACK_KING;
+    }
+
+    return newBoard;
+}
+
+
+
+// --- Text Notation ---
+
+const char* const START_FEN = "W:W21,22,23,24,25,26,27,28,29,30,31,32:B1,2,3,4,5,6,7,8,9,10,11,12";
+
+// Parse one colour's piece list, e.g. "W21,22,K30"
+static bool parseFenPieces(const string& field, Bitboard& board) {
+    bool isWhite = field[0] == 'W';
+    stringstream pieces(field.substr(1));
+    string token;
+    while (getline(pieces, token, ',')) {
+        if (token.empty()) continue;
+        bool isKing = token[0] == 'K';
+        if (isKing) token = token.substr(1);
+        // At most two digits, so stoi cannot overflow on a long token
+        if (token.empty() || token.size() > 2 || token.find_first_not_of("0123456789") != string::npos) return false;
+
+        int square = stoi(token) - 1;
+        if (square < 0 || square >= 32) return false;
+        uint32_t bit = 1u << square;
+        if ((board.white | board.black) & bit) return false; // Square listed twice
+        (isWhite ? board.white : board.black) |= bit;
+        if (isKing) board.kings |= bit;
+    }
+    return true;
+}
+
+bool parseFen(const string& fen, Bitboard& board, char& sideToMove) {
+    stringstream fields(fen);
+    string side, first, second;
+    if (!getline(fields, side, ':') || !getline(fields, first, ':') || !getline(fields, second, ':')) return false;
+    if ((side != "W" && side != "B") || first.empty() || second.empty() || first[0] == second[0]) return false;
+    if ((first[0] != 'W' && first[0] != 'B') || (second[0] != 'W' && second[0] != 'B')) return false;
+
+    Bitboard parsed = { 0, 0, 0, 0 };
+    if (!parseFenPieces(first, parsed) || !parseFenPieces(second, parsed)) return false;
+
+    sideToMove = side[0];
+    parsed.hash = computeHash(parsed, sideToMove);
+    parsed.terms = computeEvalTerms(parsed);
+    board = parsed;
+    return true;
+}
+
+// Append one colour's pieces in ascending square order
+static void appendFenPieces(string& fen, char colour, uint32_t pieces, uint32_t kings) {
+    fen += colour;
+    bool first = true;
+    for (; pieces; pieces &= pieces - 1) {
+        int square = countr_zero(pieces);
+        if (!first) fen += ',';
+        if ((kings >> square) & 1u) fen += 'K';
+        fen += to_string(square + 1);
+        first = false;
+    }
+}
+
+string toFen(const Bitboard& board, char sideToMove) {
+    string fen(1, sideToMove);
+    fen += ':';
+    appendFenPieces(fen, 'W', board.white, board.kings);
+    fen += ':';
+    appendFenPieces(fen, 'B', board.black, board.kings);
+    return fen;
+}
+
+string moveToString(const BitMove& move) {
+    return to_string(move.from + 1) + (move.captured ? "x" : "-") + to_string(move.to + 1);
+}
@@ -0,0 +1,281 @@
+#ifndef CHECKERS_BOARD_H
+#define CHECKERS_BOARD_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Define pieces
+const char WHITE_PIECE = 'w';
+const char WHITE_KING = 'W';
+const char BLACK_PIECE = 'b';
+const char BLACK_KING = 'B';
+const char EMPTY_SQUARE = ' ';
+
+// Define players
+const char WHITE = 'W'; // AI is White
+const char BLACK = 'B'; // Human is Black
+
+// Structure to represent a move
+struct Move {
+    int startRow, startCol;
+    int endRow, endCol;
+    bool isCapture; // Indicates if this move is a capture
+    std::vector<std::pair<int, int>> capturedPieces; // Coordinates of captured pieces
+};
+
+// Structure to represent a single square's coordinates
+struct Square {
+    int row, col;
+};
+
+// --- Simplified Checkers Logic ---
+
+// Basic board representation (8x8, but only dark squares are playable)
+using CheckersBoard = std::vector<std::vector<char>>;
+
+// Function to initialize a standard Checkers starting board
+CheckersBoard initializeBoard();
+
+// Helper function to check if a square is on the board and is a dark square
+bool isValidSquare(int row, int col);
+
+// Simplified function to check if a move is valid (basic movement and capture)
+// Checks a single step or a single jump; the GUI plays multi-jumps one hop at a time
+// and does not enforce mandatory captures
+bool isValidMove(const CheckersBoard& board, const Move& move, char currentPlayer);
+
+// --- Bitboard Engine ---
+
+// Evaluation terms, each counted for White minus Black
+enum EvalTerm {
+    TERM_MEN,         // Men
+    TERM_KINGS,       // Kings
+    TERM_ADVANCEMENT, // Rows the men have advanced from their own back rank
+    TERM_BACK_RANK,   // Men still guarding their own back rank against crowning
+    TERM_CENTER,      // Pieces on the eight central squares
+    // Computed from the whole position when it is evaluated (and only if weighted);
+    // makeMove does not keep them up to date and leaves them 0
+    TERM_RUNAWAYS,    // Men with no opposing piece in the triangle in front of them
+    TERM_MOBILITY,    // Simple moves available (ignoring that captures are mandatory)
+    EVAL_TERM_COUNT
+};
+// The terms makeMove updates incrementally: the per-piece, per-square ones
+const int INCREMENTAL_TERM_COUNT = TERM_RUNAWAYS;
+// Padded with zeros to eight lanes so one position fills a 128-bit vector in evaluateBoards
+const int EVAL_TERM_LANES = 8;
+using EvalTerms = std::array<int16_t, EVAL_TERM_LANES>;
+
+// The search works on a compact bitboard instead of the 8x8 CheckersBoard.
+// The 32 playable (dark) squares are numbered 0..31 row by row from the top:
+// square s sits on row s / 4, and each row holds four dark squares.
+struct Bitboard {
+    uint32_t white;  // All White pieces (men and kings)
+    uint32_t black;  // All Black pieces (men and kings)
+    uint32_t kings;  // Kings of either colour
+    uint64_t hash;   // Zobrist key of the position, side to move included
+    EvalTerms terms; // Evaluation terms, kept up to date by makeMove like the hash
+};
+
+// Compact move used by the search: start/end squares and a mask of captured squares
+struct BitMove {
+    uint8_t from, to;
+    uint32_t captured; // Non-zero for capture moves
+};
+
+inline bool sameMove(const BitMove& a, const BitMove& b) {
+    return a.from == b.from && a.to == b.to && a.captured == b.captured;
+}
+
+// Move list with its storage inline, for the search's per-ply lists. Real positions
+// have far fewer moves than INLINE_CAPACITY; a list that outgrows it continues in a
+// spill vector, which keeps its capacity when the list is cleared and refilled, so a
+// reused list allocates at most while it warms up.
+class MoveList {
+public:
+    static const size_t INLINE_CAPACITY = 64;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    BitMove* begin() { return spilled ? spill.data() : inlineMoves; }
+    BitMove* end() { return begin() + count; }
+    const BitMove* begin() const { return spilled ? spill.data() : inlineMoves; }
+    const BitMove* end() const { return begin() + count; }
+    BitMove& operator[](size_t index) { return begin()[index]; }
+    const BitMove& operator[](size_t index) const { return begin()[index]; }
+    const BitMove& front() const { return begin()[0]; }
+
+    void clear() {
+        count = 0;
+        spilled = false;
+        spill.clear();
+    }
+
+    void push_back(const BitMove& move) {
+        if (spilled) spill.push_back(move);
+        else if (count < INLINE_CAPACITY) inlineMoves[count] = move;
+        else {
+            spill.assign(inlineMoves, inlineMoves + count);
+            spill.push_back(move);
+            spilled = true;
+        }
+        ++count;
+    }
+
+private:
+    BitMove inlineMoves[INLINE_CAPACITY];
+    size_t count = 0;
+    bool spilled = false;      // The moves live in spill instead of inlineMoves
+    std::vector<BitMove> spill;
+};
+
+inline char opponentOf(char player) {
+    return player == WHITE ? BLACK : WHITE;
+}
+
+// Convert between (row, col) coordinates and playable square indices
+constexpr int squareIndex(int row, int col) {
+    return row * 4 + col / 2;
+}
+
+constexpr int squareRow(int square) {
+    return square / 4;
+}
+
+constexpr int squareCol(int square) {
+    // Even rows start with a light square, so their dark squares are the odd columns
+    return (square % 4) * 2 + (squareRow(square) % 2 == 0 ? 1 : 0);
+}
+
+// Returns the square one diagonal step away, or -1 if it falls off the board
+// (a diagonal step from a dark square always lands on a dark square)
+constexpr int neighborSquare(int square, int rowDir, int colDir) {
+    int row = squareRow(square) + rowDir;
+    int col = squareCol(square) + colDir;
+    if (row < 0 || row >= 8 || col < 0 || col >= 8) return -1;
+    return squareIndex(row, col);
+}
+
+// Compute a position's Zobrist key from scratch (applyMove keeps it up to date afterwards)
+uint64_t computeHash(const Bitboard& board, char sideToMove);
+
+// Compute a position's evaluation terms from scratch (makeMove updates them per move)
+EvalTerms computeEvalTerms(const Bitboard& board);
+
+// Evaluation terms of the position after a move, without making it
+EvalTerms evalTermsAfterMove(const Bitboard& board, const BitMove& move);
+
+// Build a bitboard from the GUI's 8x8 representation
+Bitboard toBitboard(const CheckersBoard& board, char sideToMove = WHITE);
+
+// Expand a bitboard back into the GUI's 8x8 representation
+CheckersBoard toCheckersBoard(const Bitboard& bitboard);
+
+// Expand a bitboard move into the GUI's Move structure
+Move toMove(const BitMove& bitMove);
+
+// Everything unmakeMove needs to take a move back
+struct UndoRecord {
+    BitMove move;
+    uint32_t capturedKings; // Captured squares that held kings
+    bool promoted;          // The moving man was crowned
+    uint64_t hashDelta;     // XOR that restores the previous Zobrist key
+    EvalTerms terms;        // Evaluation terms before the move
+};
+
+// Function to generate all legal moves for the current player on a bitboard
+// Captures are mandatory and each capture move is a complete multi-jump sequence,
+// with every jumped square in `captured`; a man's sequence ends when it is crowned
+std::vector<BitMove> generateLegalMoves(const Bitboard& board, char currentPlayer);
+
+// Same, but refills `moves` in place so callers can reuse its capacity
+void generateLegalMoves(const Bitboard& board, char currentPlayer, std::vector<BitMove>& moves);
+void generateLegalMoves(const Bitboard& board, char currentPlayer, MoveList& moves);
+
+// True if the player has a capture available (and so must capture); much cheaper
+// than generating the moves
+bool hasCapture(const Bitboard& board, char currentPlayer);
+
+// In-place make/unmake used by the search; no copies, no allocation
+void makeMove(Bitboard& board, const BitMove& move, UndoRecord& undo);
+void unmakeMove(Bitboard& board, const UndoRecord& undo);
+
+// Function to apply a move to a bitboard, returning the new position
+Bitboard applyMove(const Bitboard& board, const BitMove& move);
+
+// Weight of each evaluation term, in hundredths of a man
+struct EvalWeights {
+    int man = 100;
+    int king = 300; // Kings are more valuable
+    int advancement = 4; // Also called tempo
+    int backRank = 15;
+    int center = 10;
+    int runaway = 0;  // Off by default: the whole-position terms cost a board scan per leaf
+    int mobility = 0;
+};
+
+// Set one weight by its name in weight files and engine specs: man, king, advancement,
+// backrank, center, runaway, mobility. Returns false for an unknown name.
+bool setEvalWeight(EvalWeights& weights, const std::string& name, int value);
+
+// Weight files hold one "<name> <value>" per line; '#' starts a comment. Weights the
+// file does not name keep their value. Returns false if the file cannot be read or
+// has a malformed line.
+bool loadEvalWeights(const std::string& path, EvalWeights& weights);
+bool saveEvalWeights(const std::string& path, const EvalWeights& weights);
+
+// True if the weights use the terms that are computed from the whole position
+inline bool usesPositionalTerms(const EvalWeights& weights) {
+    return weights.runaway != 0 || weights.mobility != 0;
+}
+
+// Fill in TERM_RUNAWAYS and TERM_MOBILITY of `terms` for the position
+void addPositionalTerms(const Bitboard& board, EvalTerms& terms);
+
+// The weighted sum of a complete set of terms
+int evaluateTerms(const EvalTerms& terms, const EvalWeights& weights);
+
+// Bitboard evaluation: the weighted sum of the board's incremental terms, O(1); the
+// positional terms are added from a scan of the board when they are weighted
+// Positive value favors White (AI), negative favors Black (Human)
+int evaluateBoard(const Bitboard& board, const EvalWeights& weights);
+int evaluateBoard(const Bitboard& board);
+
+// Batched evaluation: scores[i] = evaluateTerms of terms[i] (which must include the
+// positional terms if they are weighted). Uses
+// AVX2 or SSE2 kernels when the CPU has them (chosen once at startup), else scalar code.
+void evaluateBoards(const EvalTerms* terms, size_t count, const EvalWeights& weights, int* scores);
+
+// Name of the kernel evaluateBoards uses: "avx2", "sse2" or "scalar"
+const char* evaluationKernelName();
+
+// 8x8 wrappers used by the GUI; they convert at the edge and call the bitboard engine
+
+// Function to generate all possible legal moves for the current player (simplified)
+std::vector<Move> generateLegalMoves(const CheckersBoard& board, char currentPlayer);
+
+// Simplified evaluation function (based on piece count and king count)
+// Positive value favors White (AI), negative favors Black (Human)
+int evaluateBoard(const CheckersBoard& board);
+
+// Function to apply a move to the board
+CheckersBoard applyMove(const CheckersBoard& board, const Move& move);
+
+// --- Text Notation ---
+
+// Positions use the PDN FEN layout "W:W21,22,K30:B1,2,K5": side to move, then each
+// colour's pieces as 1-based square numbers (square index + 1), kings prefixed with K.
+// Returns false if the string is malformed.
+bool parseFen(const std::string& fen, Bitboard& board, char& sideToMove);
+
+std::string toFen(const Bitboard& board, char sideToMove);
+
+// FEN of the standard starting position with White to move
+extern const char* const START_FEN;
+
+// Moves use PDN square numbers: "22-18" for a step, "22x15" for a capture
+std::string moveToString(const BitMove& move);
+
+#endif // CHECKERS_BOARD_H
@@ -0,0 +1,388 @@
+#include "game_log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+
+using namespace std;
+
+// A log file is a 16-byte header ("CKGL", format version) followed by 32-byte
+// records (little-endian, as laid out in the record structs below)
+const char GAME_LOG_MAGIC[4] = { 'C', 'K', 'G', 'L' };
+const uint32_t GAME_LOG_VERSION = 1;
+const uint64_t GAME_LOG_HEADER_SIZE = 16;
+const size_t GAME_LOG_RECORD_SIZE = 32;
+
+struct GameLogHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t reserved;
+};
+static_assert(sizeof(GameLogHeader) == GAME_LOG_HEADER_SIZE, "game log header layout");
+
+// The first byte of every record says what it holds
+enum RecordType : uint8_t { RECORD_GAME_START = 1, RECORD_MOVE = 2, RECORD_GAME_END = 3 };
+
+struct StartRecord {
+    uint8_t type;
+    char sideToMove;
+    uint8_t reserved[2];
+    uint32_t white, black, kings;
+    int64_t startTime;
+    uint64_t reserved2;
+};
+
+struct MoveRecord {
+    uint8_t type;
+    uint8_t from, to;
+    uint8_t source;
+    uint8_t depth;
+    uint8_t reserved[3];
+    uint32_t captured;
+    int32_t score;
+    uint32_t timeMs;
+    uint32_t reserved2;
+    uint64_t nodes;
+};
+
+struct EndRecord {
+    uint8_t type;
+    int8_t result;
+    uint8_t reserved[30];
+};
+
+static_assert(sizeof(StartRecord) == GAME_LOG_RECORD_SIZE, "game log records are 32 bytes");
+static_assert(sizeof(MoveRecord) == GAME_LOG_RECORD_SIZE, "game log records are 32 bytes");
+static_assert(sizeof(EndRecord) == GAME_LOG_RECORD_SIZE, "game log records are 32 bytes");
+
+static bool readHeader(FILE* file) {
+    GameLogHeader header = {};
+    return fread(&header, sizeof(header), 1, file) == 1
+        && memcmp(header.magic, GAME_LOG_MAGIC, sizeof(header.magic)) == 0
+        && header.version == GAME_LOG_VERSION;
+}
+
+LoggedMove loggedMove(const SearchResult& result) {
+    LoggedMove move;
+    move.move = result.bestMove;
+    move.source = result.fromBook ? MOVE_FROM_BOOK : MOVE_SEARCHED;
+    move.depth = result.depth;
+    move.score = result.score;
+    move.nodes = result.nodes;
+    move.timeMs = (uint32_t)(result.seconds * 1000.0 + 0.5);
+    return move;
+}
+
+bool replayLoggedGame(const LoggedGame& game, vector<Bitboard>& positions) {
+    positions.clear();
+    positions.reserve(game.moves.size() + 1);
+    positions.push_back(game.start);
+    char sideToMove = game.startSide;
+    for (const LoggedMove& logged : game.moves) {
+        const Bitboard& board = positions.back();
+        const BitMove& move = logged.move;
+        uint32_t own = sideToMove == WHITE ? board.white : board.black;
+        uint32_t opponent = sideToMove == WHITE ? board.black : board.white;
+        if (move.from >= 32 || move.to >= 32 || !(own & (1u << move.from)) || (move.captured & ~opponent)) return false;
+        if (move.to != move.from && ((board.white | board.black) & (1u << move.to))) return false;
+        positions.push_back(applyMove(board, move));
+        sideToMove = opponentOf(sideToMove);
+    }
+    return true;
+}
+
+
+// --- Writing ---
+
+bool GameLogWriter::open(const string& path) {
+    close();
+    error_code error;
+    uint64_t size = filesystem::exists(path, error) ? filesystem::file_size(path, error) : 0;
+    if (error) return false;
+    if (size > 0) {
+        FILE* existing = fopen(path.c_str(), "rb");
+        bool valid = existing && readHeader(existing);
+        if (existing) fclose(existing);
+        if (!valid) return false;
+        // A record torn by a crash would misalign everything appended after it
+        uint64_t torn = (size - GAME_LOG_HEADER_SIZE) % GAME_LOG_RECORD_SIZE;
+        if (torn > 0) {
+            filesystem::resize_file(path, size - torn, error);
+            if (error) return false;
+        }
+    }
+
+    file = fopen(path.c_str(), "ab");
+    if (!file) return false;
+    if (size == 0) {
+        GameLogHeader header = {};
+        memcpy(header.magic, GAME_LOG_MAGIC, sizeof(header.magic));
+        header.version = GAME_LOG_VERSION;
+        if (!write(&header, sizeof(header), true)) {
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void GameLogWriter::close() {
+    if (file) fclose(file);
+    file = nullptr;
+}
+
+bool GameLogWriter::write(const void* data, size_t size, bool flush) {
+    return file && fwrite(data, size, 1, file) == 1 && (!flush || fflush(file) == 0);
+}
+
+static StartRecord startRecord(const Bitboard& board, char sideToMove, int64_t startTime) {
+    StartRecord record = {};
+    record.type = RECORD_GAME_START;
+    record.sideToMove = sideToMove;
+    record.white = board.white;
+    record.black = board.black;
+    record.kings = board.kings;
+    record.startTime = startTime != 0 ? startTime : (int64_t)time(nullptr);
+    return record;
+}
+
+static MoveRecord moveRecord(const LoggedMove& move) {
+    MoveRecord record = {};
+    record.type = RECORD_MOVE;
+    record.from = move.move.from;
+    record.to = move.move.to;
+    record.source = move.source;
+    record.depth = (uint8_t)clamp(move.depth, 0, 255);
+    record.captured = move.move.captured;
+    record.score = move.score;
+    record.timeMs = move.timeMs;
+    record.nodes = move.nodes;
+    return record;
+}
+
+static EndRecord endRecord(int result) {
+    EndRecord record = {};
+    record.type = RECORD_GAME_END;
+    record.result = (int8_t)result;
+    return record;
+}
+
+bool GameLogWriter::beginGame(const Bitboard& board, char sideToMove, int64_t startTime) {
+    StartRecord record = startRecord(board, sideToMove, startTime);
+    return write(&record, sizeof(record), true);
+}
+
+bool GameLogWriter::logMove(const LoggedMove& move) {
+    MoveRecord record = moveRecord(move);
+    return write(&record, sizeof(record), true);
+}
+
+bool GameLogWriter::endGame(int result) {
+    EndRecord record = endRecord(result);
+    return write(&record, sizeof(record), true);
+}
+
+bool GameLogWriter::writeGame(const LoggedGame& game) {
+    StartRecord start = startRecord(game.start, game.startSide, game.startTime);
+    bool written = write(&start, sizeof(start), false);
+    for (const LoggedMove& move : game.moves) {
+        MoveRecord record = moveRecord(move);
+        written = written && write(&record, sizeof(record), false);
+    }
+    EndRecord end = endRecord(game.result);
+    return written && write(&end, sizeof(end), true);
+}
+
+
+// --- Reading ---
+
+bool GameLogReader::open(const string& path) {
+    close();
+    file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    if (!readHeader(file)) {
+        close();
+        return false;
+    }
+    position = closedEnd = GAME_LOG_HEADER_SIZE;
+    return true;
+}
+
+void GameLogReader::close() {
+    if (file) fclose(file);
+    file = nullptr;
+    hasPending = false;
+}
+
+bool GameLogReader::seek(uint64_t offset) {
+    if (!file || offset < GAME_LOG_HEADER_SIZE || (offset - GAME_LOG_HEADER_SIZE) % GAME_LOG_RECORD_SIZE != 0) return false;
+    clearerr(file);
+    if (fseek(file, (long)offset, SEEK_SET) != 0) return false;
+    position = closedEnd = offset;
+    hasPending = false;
+    return true;
+}
+
+bool GameLogReader::readRecord(unsigned char* record) {
+    if (fread(record, GAME_LOG_RECORD_SIZE, 1, file) != 1) return false; // The end, or a torn last record
+    position += GAME_LOG_RECORD_SIZE;
+    return true;
+}
+
+bool GameLogReader::next(LoggedGame& game) {
+    if (!file) return false;
+
+    // Find the next game start; moves and ends outside a game are skipped
+    unsigned char record[GAME_LOG_RECORD_SIZE];
+    StartRecord start;
+    for (;;) {
+        if (hasPending) {
+            memcpy(record, pending, sizeof(record));
+            hasPending = false;
+        }
+        else if (!readRecord(record)) {
+            return false;
+        }
+        if (record[0] != RECORD_GAME_START) continue;
+        memcpy(&start, record, sizeof(start));
+        bool valid = (start.sideToMove == WHITE || start.sideToMove == BLACK) && !(start.white & start.black)
+                  && !(start.kings & ~(start.white | start.black));
+        if (valid) break;
+    }
+
+    game.offset = position - GAME_LOG_RECORD_SIZE;
+    game.startTime = start.startTime;
+    game.start = { start.white, start.black, start.kings, 0 };
+    game.start.hash = computeHash(game.start, start.sideToMove);
+    game.start.terms = computeEvalTerms(game.start);
+    game.startSide = start.sideToMove;
+    game.moves.clear();
+    game.result = GAME_UNFINISHED;
+    game.closed = false;
+
+    while (readRecord(record)) {
+        if (record[0] == RECORD_MOVE) {
+            MoveRecord logged;
+            memcpy(&logged, record, sizeof(logged));
+            LoggedMove move;
+            move.move = { logged.from, logged.to, logged.captured };
+            move.source = (MoveSource)logged.source;
+            move.depth = logged.depth;
+            move.score = logged.score;
+            move.nodes = logged.nodes;
+            move.timeMs = logged.timeMs;
+            game.moves.push_back(move);
+        }
+        else if (record[0] == RECORD_GAME_END) {
+            EndRecord end;
+            memcpy(&end, record, sizeof(end));
+            game.result = end.result;
+            game.closed = true;
+            closedEnd = position;
+            return true;
+        }
+        else if (record[0] == RECORD_GAME_START) {
+            // The game was never ended (its window was killed); the next one starts here
+            memcpy(pending, record, sizeof(pending));
+            hasPending = true;
+            game.closed = true;
+            closedEnd = position - GAME_LOG_RECORD_SIZE;
+            return true;
+        }
+    }
+    return true; // The log ends inside this game
+}
+
+
+// --- Position Index ---
+
+// An index file is a 32-byte header ("CKGI", format version, entry count, indexed
+// log bytes) followed by the entries sorted by key, then game offset and ply
+const char GAME_INDEX_MAGIC[4] = { 'C', 'K', 'G', 'I' };
+const uint32_t GAME_INDEX_VERSION = 1;
+
+struct GameIndexHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t entries;
+    uint64_t logBytes;
+    uint64_t reserved;
+};
+
+static bool entryBefore(const GameIndexEntry& a, const GameIndexEntry& b) {
+    if (a.key != b.key) return a.key < b.key;
+    if (a.gameOffset != b.gameOffset) return a.gameOffset < b.gameOffset;
+    return a.ply < b.ply;
+}
+
+bool GameLogIndex::load(const string& path) {
+    entries.clear();
+    logBytes = 0;
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    GameIndexHeader header = {};
+    bool valid = fread(&header, sizeof(header), 1, file) == 1
+              && memcmp(header.magic, GAME_INDEX_MAGIC, sizeof(header.magic)) == 0
+              && header.version == GAME_INDEX_VERSION;
+    if (valid) {
+        entries.resize(header.entries);
+        valid = fread(entries.data(), sizeof(GameIndexEntry), entries.size(), file) == entries.size();
+    }
+    fclose(file);
+    if (!valid) {
+        entries.clear();
+        return false;
+    }
+    logBytes = header.logBytes;
+    if (!is_sorted(entries.begin(), entries.end(), entryBefore)) sort(entries.begin(), entries.end(), entryBefore);
+    return true;
+}
+
+bool GameLogIndex::save(const string& path) const {
+    GameIndexHeader header = {};
+    memcpy(header.magic, GAME_INDEX_MAGIC, sizeof(header.magic));
+    header.version = GAME_INDEX_VERSION;
+    header.entries = entries.size();
+    header.logBytes = logBytes;
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+                && fwrite(entries.data(), sizeof(GameIndexEntry), entries.size(), file) == entries.size();
+    return fclose(file) == 0 && written;
+}
+
+bool GameLogIndex::update(const string& logPath) {
+    error_code error;
+    uint64_t size = filesystem::file_size(logPath, error);
+    GameLogReader reader;
+    if (error || size < logBytes || !reader.open(logPath)) return false;
+    if (logBytes > 0 && !reader.seek(logBytes)) return false;
+
+    // Only closed games: one the log ends inside may still grow and is indexed next time
+    size_t firstNew = entries.size();
+    LoggedGame game;
+    vector<Bitboard> positions;
+    while (reader.next(game) && game.closed) {
+        if (!replayLoggedGame(game, positions)) continue; // Damaged games are left out
+        for (size_t ply = 0; ply < positions.size(); ++ply) {
+            entries.push_back({ positions[ply].hash, game.offset, (uint32_t)ply, 0 });
+        }
+    }
+    logBytes = reader.closedOffset();
+
+    sort(entries.begin() + firstNew, entries.end(), entryBefore);
+    inplace_merge(entries.begin(), entries.begin() + firstNew, entries.end(), entryBefore);
+    return true;
+}
+
+vector<GameIndexEntry> GameLogIndex::find(uint64_t key) const {
+    GameIndexEntry target = {};
+    target.key = key;
+    auto first = lower_bound(entries.begin(), entries.end(), target,
+                             [](const GameIndexEntry& a, const GameIndexEntry& b) { return a.key < b.key; });
+    auto last = first;
+    while (last != entries.end() && last->key == key) ++last;
+    return vector<GameIndexEntry>(first, last);
+}
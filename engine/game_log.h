@@ -0,0 +1,141 @@
+#ifndef CHECKERS_GAME_LOG_H
+#define CHECKERS_GAME_LOG_H
+
+#include "board.h"
+#include "search.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Where a logged move came from
+enum MoveSource : uint8_t {
+    MOVE_SEARCHED,  // Chosen by findBestMove's search
+    MOVE_FROM_BOOK, // Played from the opening book without searching
+    MOVE_BY_HUMAN,  // Played in the GUI; depth, score and nodes are 0
+};
+
+// One move of a logged game with the search behind it
+struct LoggedMove {
+    BitMove move;
+    MoveSource source = MOVE_SEARCHED;
+    int depth = 0;       // Deepest completed iteration
+    int score = 0;       // From White's point of view
+    uint64_t nodes = 0;
+    uint32_t timeMs = 0; // Thinking time, the human's included
+};
+
+// The move a search chose, with its depth, score, nodes and time
+LoggedMove loggedMove(const SearchResult& result);
+
+// Result of a game that has no result: the log ends inside it, or the window was closed
+const int GAME_UNFINISHED = 2;
+
+// One logged game
+struct LoggedGame {
+    uint64_t offset = 0;      // Byte offset of its first record, for GameLogReader::seek
+    int64_t startTime = 0;    // Unix time in seconds
+    Bitboard start = {};
+    char startSide = WHITE;
+    std::vector<LoggedMove> moves;
+    int result = GAME_UNFINISHED; // +1 White won, -1 Black won, 0 draw, or GAME_UNFINISHED
+    bool closed = false;          // False if the log ends inside the game, which may still be written to
+};
+
+// The positions of a game, start position first and the position after the last move
+// last; the side to move alternates from game.startSide. Returns false if a move does
+// not fit its position, which only happens in a damaged log.
+bool replayLoggedGame(const LoggedGame& game, std::vector<Bitboard>& positions);
+
+// Appends games to a log file. A log is a 16-byte header ("CKGL", format version)
+// followed by 32-byte records: a game start with the start position, one record per
+// move, and a game end with the result. Every record is flushed as it is written, so a
+// crash loses at most the move being written; open() drops a torn record at the end
+// of the file. One writer per file at a time.
+class GameLogWriter {
+public:
+    ~GameLogWriter() { close(); }
+
+    // Open or create the log for appending; returns false if it cannot be written or
+    // is not a game log
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    // Record the start of a game; startTime 0 means now
+    bool beginGame(const Bitboard& board, char sideToMove, int64_t startTime = 0);
+    bool logMove(const LoggedMove& move);
+    bool endGame(int result);
+
+    // A whole game at once, with a single flush
+    bool writeGame(const LoggedGame& game);
+
+private:
+    bool write(const void* data, size_t size, bool flush);
+
+    FILE* file = nullptr;
+};
+
+// Streams the games of a log one at a time, so logs far larger than memory can be read
+class GameLogReader {
+public:
+    ~GameLogReader() { close(); }
+
+    // Returns false if the file cannot be read or is not a game log
+    bool open(const std::string& path);
+    void close();
+
+    // Read the next game; returns false at the end of the log
+    bool next(LoggedGame& game);
+
+    // Continue reading at a game offset from LoggedGame::offset or the index
+    bool seek(uint64_t offset);
+
+    // Offset just past the last game next() returned with closed set
+    uint64_t closedOffset() const { return closedEnd; }
+
+private:
+    bool readRecord(unsigned char* record);
+
+    FILE* file = nullptr;
+    uint64_t position = 0;  // Offset of the next record to read
+    bool hasPending = false; // A game start read while finishing the previous game
+    unsigned char pending[32];
+    uint64_t closedEnd = 0;
+};
+
+// One position of a logged game: its Zobrist key (side to move included), the game and the ply
+struct GameIndexEntry {
+    uint64_t key;
+    uint64_t gameOffset;
+    uint32_t ply;         // Moves played before the position
+    uint32_t reserved;
+};
+static_assert(sizeof(GameIndexEntry) == 24, "index entries are stored as-is on disk");
+
+// Index of every position in a log by its key, sorted and looked up by binary search
+// like the opening book. It covers the log's closed games up to indexedBytes(), so a
+// log that grew since can be indexed further with update().
+class GameLogIndex {
+public:
+    // Replace the index with the contents of an index file; returns false if it cannot be read
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    // Add the closed games of the log past indexedBytes(); returns false if the log
+    // cannot be read or is shorter than the part already indexed
+    bool update(const std::string& logPath);
+
+    size_t size() const { return entries.size(); }
+    uint64_t indexedBytes() const { return logBytes; }
+
+    // Every occurrence of a position, by game offset and ply
+    std::vector<GameIndexEntry> find(uint64_t key) const;
+
+private:
+    std::vector<GameIndexEntry> entries;
+    uint64_t logBytes = 0;
+};
+
+#endif // CHECKERS_GAME_LOG_H
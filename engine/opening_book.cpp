@@ -0,0 +1,148 @@
+#include "opening_book.h"
+
+#include "search.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+
+using namespace std;
+
+OpeningBook openingBook;
+
+// A book file is a 16-byte header ("CKBK", format version, entry count) followed
+// by the entries sorted by key (little-endian, as laid out in BookEntry)
+const char BOOK_MAGIC[4] = { 'C', 'K', 'B', 'K' };
+const uint32_t BOOK_VERSION = 1;
+
+struct BookHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t entries;
+};
+
+static bool keyBefore(const BookEntry& a, const BookEntry& b) {
+    return a.key < b.key;
+}
+
+bool OpeningBook::load(const string& path) {
+    entries.clear();
+    error_code error;
+    uint64_t fileSize = filesystem::file_size(path, error);
+    if (error) return false;
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    BookHeader header = {};
+    // The entry count must match the file size, so a damaged header cannot ask for a huge allocation
+    bool valid = fread(&header, sizeof(header), 1, file) == 1
+              && memcmp(header.magic, BOOK_MAGIC, sizeof(header.magic)) == 0
+              && header.version == BOOK_VERSION
+              && header.entries == (fileSize - sizeof(header)) / sizeof(BookEntry)
+              && (fileSize - sizeof(header)) % sizeof(BookEntry) == 0;
+    if (valid) {
+        entries.resize(header.entries);
+        valid = fread(entries.data(), sizeof(BookEntry), entries.size(), file) == entries.size();
+    }
+    fclose(file);
+    if (!valid) {
+        entries.clear();
+        return false;
+    }
+    if (!is_sorted(entries.begin(), entries.end(), keyBefore)) sort(entries.begin(), entries.end(), keyBefore);
+    return true;
+}
+
+bool OpeningBook::probe(const Bitboard& board, const vector<BitMove>& legalMoves, BitMove& move, BookEntry& entry) const {
+    probes.fetch_add(1, memory_order_relaxed);
+    BookEntry target = {};
+    target.key = board.hash;
+    auto found = lower_bound(entries.begin(), entries.end(), target, keyBefore);
+    if (found == entries.end() || found->key != board.hash) return false;
+
+    // Like the transposition table, the book only keeps start and end squares
+    for (const BitMove& legal : legalMoves) {
+        if (legal.from == found->from && legal.to == found->to) {
+            move = legal;
+            entry = *found;
+            hits.fetch_add(1, memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool writeOpeningBook(const string& path, vector<BookEntry> entries) {
+    sort(entries.begin(), entries.end(), keyBefore);
+    BookHeader header = {};
+    memcpy(header.magic, BOOK_MAGIC, sizeof(header.magic));
+    header.version = BOOK_VERSION;
+    header.entries = entries.size();
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+                && fwrite(entries.data(), sizeof(BookEntry), entries.size(), file) == entries.size();
+    return fclose(file) == 0 && written;
+}
+
+
+// --- Book Building ---
+
+struct BookBuilder {
+    int plies;
+    int depth;
+    int threads;
+    const BookProgressCallback* onPosition;
+    unordered_map<uint64_t, BookEntry> entries;
+    unordered_map<uint64_t, int> visited; // Shallowest ply each position was expanded from, per book side
+};
+
+// Give the book side's positions a searched move and follow it; try every move of the other side
+static void expandBook(BookBuilder& builder, const Bitboard& board, char sideToMove, char bookSide, int ply) {
+    if (ply >= builder.plies) return;
+    auto [visit, firstVisit] = builder.visited.try_emplace(board.hash, ply);
+    if (!firstVisit) {
+        if (visit->second <= ply) return; // Already expanded at least this deep
+        visit->second = ply;
+    }
+
+    vector<BitMove> moves = generateLegalMoves(board, sideToMove);
+    if (moves.empty()) return;
+
+    if (sideToMove == bookSide) {
+        auto known = builder.entries.find(board.hash);
+        if (known == builder.entries.end()) {
+            SearchResult result = findBestMove(board, sideToMove, builder.depth, 0, builder.threads);
+            BookEntry entry = { board.hash, result.score, result.bestMove.from, result.bestMove.to, (uint8_t)result.depth, 0 };
+            known = builder.entries.emplace(board.hash, entry).first;
+            if (*builder.onPosition) (*builder.onPosition)(builder.entries.size(), board, sideToMove, entry);
+        }
+        for (const BitMove& move : moves) {
+            if (move.from == known->second.from && move.to == known->second.to) {
+                expandBook(builder, applyMove(board, move), opponentOf(sideToMove), bookSide, ply + 1);
+                break;
+            }
+        }
+    }
+    else {
+        for (const BitMove& move : moves) {
+            expandBook(builder, applyMove(board, move), opponentOf(sideToMove), bookSide, ply + 1);
+        }
+    }
+}
+
+vector<BookEntry> buildOpeningBook(int plies, int depth, int threads, const BookProgressCallback& onPosition) {
+    BookBuilder builder = { plies, depth, threads, &onPosition, {}, {} };
+    Bitboard start = toBitboard(initializeBoard());
+    for (char bookSide : { WHITE, BLACK }) {
+        builder.visited.clear();
+        expandBook(builder, start, WHITE, bookSide, 0);
+    }
+
+    vector<BookEntry> entries;
+    entries.reserve(builder.entries.size());
+    for (const auto& [key, entry] : builder.entries) entries.push_back(entry);
+    return entries;
+}
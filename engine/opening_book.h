@@ -0,0 +1,61 @@
+#ifndef CHECKERS_OPENING_BOOK_H
+#define CHECKERS_OPENING_BOOK_H
+
+#include "board.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// One book position: its Zobrist key (side to move included) and the move to play
+struct BookEntry {
+    uint64_t key;
+    int32_t score;  // Search score from White's point of view
+    uint8_t from;
+    uint8_t to;
+    uint8_t depth;  // Depth of the search that chose the move
+    uint8_t reserved;
+};
+static_assert(sizeof(BookEntry) == 16, "book entries are stored as-is on disk");
+
+// Opening book: book entries sorted by key, looked up by binary search.
+// Probes and hits are counted so front ends can report the hit rate.
+class OpeningBook {
+public:
+    // Replace the book with the contents of a book file; returns false if it cannot be read
+    bool load(const std::string& path);
+    void clear() { entries.clear(); }
+
+    size_t size() const { return entries.size(); }
+
+    // Find the book move for a position; the move must be one of legalMoves.
+    // Returns false if the position is not in the book.
+    bool probe(const Bitboard& board, const std::vector<BitMove>& legalMoves, BitMove& move, BookEntry& entry) const;
+
+    uint64_t probeCount() const { return probes.load(std::memory_order_relaxed); }
+    uint64_t hitCount() const { return hits.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<BookEntry> entries;
+    mutable std::atomic<uint64_t> probes{ 0 };
+    mutable std::atomic<uint64_t> hits{ 0 };
+};
+
+// Book consulted by findBestMove, empty until load() is called
+extern OpeningBook openingBook;
+
+// Write entries (in any order) as a book file; returns false on an I/O error
+bool writeOpeningBook(const std::string& path, std::vector<BookEntry> entries);
+
+// Called by buildOpeningBook after every searched position
+using BookProgressCallback = std::function<void(size_t positions, const Bitboard& board, char sideToMove, const BookEntry& entry)>;
+
+// Build a book from the start position by deep searches: for each side in turn, the
+// positions that side reaches in the first `plies` plies get a move searched to
+// `depth`. The book side only follows its own book moves, the other side tries
+// every legal move, so the book answers every reply within its plies.
+std::vector<BookEntry> buildOpeningBook(int plies, int depth, int threads, const BookProgressCallback& onPosition);
+
+#endif // CHECKERS_OPENING_BOOK_H
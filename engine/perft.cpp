@@ -0,0 +1,62 @@
+#include "perft.h"
+
+#include <vector>
+
+using namespace std;
+
+// Recursive counter using make/unmake and one reused move list per ply
+static uint64_t perftMoves(Bitboard& board, char sideToMove, int depth, vector<MoveList>& moveLists) {
+    MoveList& moves = moveLists[depth];
+    generateLegalMoves(board, sideToMove, moves);
+    // Bulk count: the last ply only needs the number of moves
+    if (depth == 1) return moves.size();
+
+    uint64_t nodes = 0;
+    for (const auto& move : moves) {
+        UndoRecord undo;
+        makeMove(board, move, undo);
+        nodes += perftMoves(board, opponentOf(sideToMove), depth - 1, moveLists);
+        unmakeMove(board, undo);
+    }
+    return nodes;
+}
+
+// True if the incremental hash and terms match the ones computed from scratch
+static bool incrementalStateMatches(const Bitboard& board, char sideToMove) {
+    return board.hash == computeHash(board, sideToMove) && board.terms == computeEvalTerms(board);
+}
+
+static uint64_t checkMoves(Bitboard& board, char sideToMove, int depth, vector<MoveList>& moveLists, uint64_t& mismatches) {
+    if (!incrementalStateMatches(board, sideToMove)) ++mismatches;
+    if (depth == 0) return 1;
+
+    MoveList& moves = moveLists[depth];
+    generateLegalMoves(board, sideToMove, moves);
+    // The quick capture test must agree with the generator
+    if (hasCapture(board, sideToMove) != (!moves.empty() && moves.front().captured != 0)) ++mismatches;
+    uint64_t nodes = 1;
+    for (const auto& move : moves) {
+        UndoRecord undo;
+        makeMove(board, move, undo);
+        nodes += checkMoves(board, opponentOf(sideToMove), depth - 1, moveLists, mismatches);
+        unmakeMove(board, undo);
+        // Taking the move back must restore the state exactly
+        if (!incrementalStateMatches(board, sideToMove)) ++mismatches;
+    }
+    return nodes;
+}
+
+uint64_t checkIncrementalState(const Bitboard& board, char sideToMove, int depth, uint64_t& mismatches) {
+    mismatches = 0;
+    Bitboard position = board;
+    vector<MoveList> moveLists(depth + 1);
+    return checkMoves(position, sideToMove, depth, moveLists, mismatches);
+}
+
+uint64_t perft(const Bitboard& board, char sideToMove, int depth) {
+    if (depth == 0) return 1;
+
+    Bitboard position = board;
+    vector<MoveList> moveLists(depth + 1);
+    return perftMoves(position, sideToMove, depth, moveLists);
+}
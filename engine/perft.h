@@ -0,0 +1,18 @@
+#ifndef CHECKERS_PERFT_H
+#define CHECKERS_PERFT_H
+
+#include "board.h"
+
+#include <cstdint>
+
+// Count the leaf nodes of the legal move tree to the given depth. Exercises
+// generateLegalMoves and applyMove only, so it doubles as their throughput benchmark.
+uint64_t perft(const Bitboard& board, char sideToMove, int depth);
+
+// Walk the move tree to the given depth with make/unmake and compare the incrementally
+// maintained hash and evaluation terms with a from-scratch recompute at every node,
+// and hasCapture with the move generator at every inner node.
+// Returns the number of nodes checked; mismatches counts the nodes that disagreed.
+uint64_t checkIncrementalState(const Bitboard& board, char sideToMove, int depth, uint64_t& mismatches);
+
+#endif // CHECKERS_PERFT_H
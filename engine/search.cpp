@@ -0,0 +1,711 @@
+#include "search.h"
+
+#include "opening_book.h"
+#include "tablebase.h"
+#include "transposition_table.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+// Move the table's best move (if it is legal here) to the front of the list
+// The table only keeps start and end squares, so match on those
+static void orderHashMove(vector<BitMove>& moves, const TTEntry* entry) {
+    if (!entry || !entry->hasMove) return;
+    for (size_t i = 0; i < moves.size(); ++i) {
+        if (moves[i].from == entry->bestMove.from && moves[i].to == entry->bestMove.to) {
+            rotate(moves.begin(), moves.begin() + i, moves.begin() + i + 1);
+            return;
+        }
+    }
+}
+
+
+// --- Search Control ---
+
+// How often (in nodes) the search looks at the clock
+const uint64_t TIME_CHECK_INTERVAL = 1024;
+
+using SearchClock = chrono::steady_clock;
+
+// Limits and settings shared by every thread of one search
+struct SearchControl {
+    SearchClock::time_point startTime;
+    SearchClock::time_point deadline;
+    bool hasDeadline = false; // Only changed between iterations, while no helper thread runs
+    const atomic<bool>* cancel = nullptr; // Set by the caller (e.g. another thread) to abort
+    atomic<bool> stop{ false };
+    TranspositionTable* table = &transpositionTable;
+    EvalWeights weights;
+    bool quiescence = true;
+    bool pvs = true;
+};
+
+// Per-thread search state threaded through negamax
+struct SearchContext {
+    SearchControl* control = nullptr;
+    bool stopped = false; // Set once the search is stopped; results after that are discarded
+    uint64_t nodes = 0;
+    uint64_t quiescenceNodes = 0; // Counted in nodes as well
+
+    // Statistics counters, see IterationStats
+    uint64_t cutoffs = 0;
+    uint64_t firstMoveCutoffs = 0;
+    uint64_t ttProbes = 0;
+    uint64_t ttHits = 0;
+    uint64_t ttCutoffs = 0;
+    uint64_t ttStores = 0;
+    uint64_t researches = 0;
+    int aspirationFailures = 0; // Only counted by the first context, which drives the root
+
+    // Move ordering heuristics, kept for the whole search (all iterations)
+    BitMove killers[MAX_SEARCH_DEPTH + 1][2] = {}; // Quiet moves that caused a cutoff, per ply
+    int history[2][32][32] = {};                    // [side][from][to] cutoff counts weighted by depth
+    int moveScores[MoveList::INLINE_CAPACITY];      // Scratch buffer of orderMoves
+    vector<int> spilledMoveScores;                  // Used instead for a list that spilled
+
+    // One inline move list per ply, reused from node to node so the search does not
+    // allocate; the capture search continues below the deepest iteration
+    MoveList moveLists[MAX_SEARCH_DEPTH + MAX_CAPTURE_PLIES + 1];
+
+    // Children of the current frontier node and their batched evaluations
+    vector<EvalTerms> frontierTerms;
+    vector<int> frontierScores;
+
+    SearchContext() {
+        frontierTerms.reserve(MoveList::INLINE_CAPACITY);
+        frontierScores.reserve(MoveList::INLINE_CAPACITY);
+    }
+};
+
+// Counts a node and checks the clock and the cancel flag every TIME_CHECK_INTERVAL nodes
+static inline bool shouldStop(SearchContext& context) {
+    SearchControl& control = *context.control;
+    if (++context.nodes % TIME_CHECK_INTERVAL == 0) {
+        bool outOfTime = control.hasDeadline && SearchClock::now() >= control.deadline;
+        bool cancelled = control.cancel && control.cancel->load(memory_order_relaxed);
+        if (outOfTime || cancelled) control.stop.store(true, memory_order_relaxed);
+    }
+    context.stopped = control.stop.load(memory_order_relaxed);
+    return context.stopped;
+}
+
+
+// Aspiration windows: the first window spans ASPIRATION_WINDOW either side of the
+// previous iteration's score; each failure widens it ASPIRATION_GROWTH times on the
+// failing side, and past ASPIRATION_MAX_WINDOW that side is opened completely
+const int ASPIRATION_WINDOW = 50;
+const int ASPIRATION_GROWTH = 4;
+const int ASPIRATION_MAX_WINDOW = 1000;
+
+
+// --- Move Ordering ---
+
+// Ordering scores; the hash move beats captures, which beat killers, which beat history
+const int HASH_MOVE_SCORE = 1 << 30;
+const int CAPTURE_SCORE = 1 << 29;
+const int KILLER_SCORE = 1 << 28;
+
+// Material a capture wins, using the evaluateBoard weights
+static inline int capturedMaterial(const Bitboard& board, const BitMove& move, const EvalWeights& weights) {
+    return weights.man * popcount(move.captured) + (weights.king - weights.man) * popcount(move.captured & board.kings);
+}
+
+// Sort moves best-first: hash move, captures by material gained, killers for this ply,
+// then quiet moves by history score. Insertion sort keeps equal moves in generator order.
+static void orderMoves(SearchContext& context, const Bitboard& board, MoveList& moves, const TTEntry* entry, int ply, int side) {
+    int* scores = context.moveScores;
+    if (moves.size() > MoveList::INLINE_CAPACITY) {
+        context.spilledMoveScores.resize(moves.size());
+        scores = context.spilledMoveScores.data();
+    }
+    for (size_t i = 0; i < moves.size(); ++i) {
+        const BitMove& move = moves[i];
+        if (entry && entry->hasMove && move.from == entry->bestMove.from && move.to == entry->bestMove.to) scores[i] = HASH_MOVE_SCORE;
+        else if (move.captured) scores[i] = CAPTURE_SCORE + capturedMaterial(board, move, context.control->weights);
+        else if (sameMove(move, context.killers[ply][0])) scores[i] = KILLER_SCORE + 1;
+        else if (sameMove(move, context.killers[ply][1])) scores[i] = KILLER_SCORE;
+        else scores[i] = context.history[side][move.from][move.to];
+    }
+
+    for (size_t i = 1; i < moves.size(); ++i) {
+        BitMove move = moves[i];
+        int score = scores[i];
+        size_t j = i;
+        for (; j > 0 && scores[j - 1] < score; --j) {
+            moves[j] = moves[j - 1];
+            scores[j] = scores[j - 1];
+        }
+        moves[j] = move;
+        scores[j] = score;
+    }
+}
+
+// A quiet move refuted this node: remember it as a killer and credit its history
+static void recordCutoff(SearchContext& context, const BitMove& move, int ply, int remainingDepth, int side) {
+    if (move.captured) return; // Captures are already ordered first
+    if (!sameMove(move, context.killers[ply][0])) {
+        context.killers[ply][1] = context.killers[ply][0];
+        context.killers[ply][0] = move;
+    }
+    context.history[side][move.from][move.to] += remainingDepth * remainingDepth;
+}
+
+
+// Score of a tablebase result from the side to move's point of view. Wins closer to
+// the root score higher, so the search heads for the quickest win and the slowest
+// loss. negamax's depth 0 is one ply below the root.
+static int tablebaseScore(TablebaseOutcome outcome, int plies, int depth) {
+    return outcome * (TABLEBASE_WIN_SCORE - (depth + 1 + plies));
+}
+
+// Scores beyond this are tablebase wins or losses; evaluations stay far below it
+const int TABLEBASE_SCORE_FLOOR = TABLEBASE_WIN_SCORE / 2;
+
+// The transposition table keeps tablebase scores counted from the stored node instead
+// of from the root, so an entry reused at another depth or in a later search still
+// reports the right distance to the end of the game. depth is the node's negamax depth.
+static int scoreToTable(int score, int depth) {
+    if (score > TABLEBASE_SCORE_FLOOR) return score + depth + 1;
+    if (score < -TABLEBASE_SCORE_FLOOR) return score - (depth + 1);
+    return score;
+}
+
+static int scoreFromTable(int score, int depth) {
+    if (score > TABLEBASE_SCORE_FLOOR) return score - (depth + 1);
+    if (score < -TABLEBASE_SCORE_FLOOR) return score + depth + 1;
+    return score;
+}
+
+// evaluateBoard from the point of view of the side to move
+static inline int evaluateFor(const SearchContext& context, const Bitboard& board, char sideToMove) {
+    int score = evaluateBoard(board, context.control->weights);
+    return sideToMove == WHITE ? score : -score;
+}
+
+static int quiescence(SearchContext& context, Bitboard& board, int depth, char sideToMove, int alpha, int beta);
+
+// Best capture in context.moveLists[depth]. Captures are mandatory, so unlike in
+// chess there is no standing pat: the side to move has to take.
+static int searchCaptures(SearchContext& context, Bitboard& board, int depth, char sideToMove, int alpha, int beta) {
+    const MoveList& captures = context.moveLists[depth];
+    int best = -INFINITE_SCORE;
+    for (const auto& move : captures) {
+        UndoRecord undo;
+        makeMove(board, move, undo);
+        int value = -quiescence(context, board, depth + 1, opponentOf(sideToMove), -beta, -alpha);
+        unmakeMove(board, undo);
+        if (context.stopped) return 0;
+
+        best = max(best, value);
+        alpha = max(alpha, best);
+        if (alpha >= beta) break;
+    }
+    return best;
+}
+
+// Quiescence search below the horizon: follow captures until the side to move has
+// none, then evaluate. Every capture removes a piece, so this always ends.
+static int quiescence(SearchContext& context, Bitboard& board, int depth, char sideToMove, int alpha, int beta) {
+    ++context.quiescenceNodes;
+    if (shouldStop(context)) return 0;
+
+    if (popcount(board.white | board.black) <= tablebases.maxPieces()) {
+        TablebaseOutcome outcome;
+        int plies;
+        if (tablebases.probe(board, sideToMove, outcome, plies)) return tablebaseScore(outcome, plies, depth);
+    }
+    if (!hasCapture(board, sideToMove)) return evaluateFor(context, board, sideToMove);
+
+    generateLegalMoves(board, sideToMove, context.moveLists[depth]);
+    return searchCaptures(context, board, depth, sideToMove, alpha, beta);
+}
+
+// One ply above the leaves: evaluate every child in one batch into context.frontierScores
+// (from White's point of view, like evaluateBoard)
+static void evaluateChildren(SearchContext& context, const Bitboard& board, const MoveList& moves) {
+    context.frontierTerms.resize(moves.size());
+    context.frontierScores.resize(moves.size());
+    if (!usesPositionalTerms(context.control->weights)) {
+        for (size_t i = 0; i < moves.size(); ++i) context.frontierTerms[i] = evalTermsAfterMove(board, moves[i]);
+    }
+    else {
+        // The positional terms need the child position itself
+        for (size_t i = 0; i < moves.size(); ++i) {
+            Bitboard child = applyMove(board, moves[i]);
+            addPositionalTerms(child, child.terms);
+            context.frontierTerms[i] = child.terms;
+        }
+    }
+    evaluateBoards(context.frontierTerms.data(), moves.size(), context.control->weights, context.frontierScores.data());
+}
+
+static int negamax(SearchContext& context, Bitboard& board, int depth, int maxDepth, char sideToMove, int alpha, int beta);
+
+// What negamax returns for a leaf child (depth == maxDepth) whose side to move is
+// sideToMove, given its batched evaluation: counted as a node, and overridden by
+// the tablebases if they know it. A child with a capture pending is searched
+// normally, which hands it to quiescence.
+static int frontierValue(SearchContext& context, Bitboard& board, const BitMove& move, int evaluation, int depth, int maxDepth,
+                         char sideToMove, int alpha, int beta) {
+    int value = sideToMove == WHITE ? evaluation : -evaluation;
+    bool probeTables = popcount(board.white | board.black) - popcount(move.captured) <= tablebases.maxPieces();
+    if (!context.control->quiescence && !probeTables) return shouldStop(context) ? 0 : value;
+
+    UndoRecord undo;
+    makeMove(board, move, undo);
+    TablebaseOutcome outcome;
+    int plies;
+    if (context.control->quiescence && hasCapture(board, sideToMove)) {
+        value = negamax(context, board, depth, maxDepth, sideToMove, alpha, beta);
+    }
+    else if (shouldStop(context)) value = 0;
+    else if (probeTables && tablebases.probe(board, sideToMove, outcome, plies)) {
+        value = tablebaseScore(outcome, plies, depth);
+    }
+    unmakeMove(board, undo);
+    return value;
+}
+
+// Alpha-beta search in negamax form with principal variation search
+// alpha, beta: the window, from the point of view of sideToMove (as is the result)
+// depth: Current search depth
+// maxDepth: Maximum search depth
+// The first move is searched with the full window. Every later move is expected to
+// be worse, so it only gets a null-window scout proving that; a move that beats
+// alpha anyway is searched again with the full window.
+// Returns 0 once context.stopped is set; callers must discard that value
+// The board is updated in place with makeMove/unmakeMove and is unchanged on return
+static int negamax(SearchContext& context, Bitboard& board, int depth, int maxDepth, char sideToMove, int alpha, int beta) {
+    if (shouldStop(context)) return 0;
+
+    // Endgame tablebases know the exact result
+    if (popcount(board.white | board.black) <= tablebases.maxPieces()) {
+        TablebaseOutcome outcome;
+        int plies;
+        if (tablebases.probe(board, sideToMove, outcome, plies)) return tablebaseScore(outcome, plies, depth);
+    }
+
+    // Base case: If max depth is reached or no legal moves for the current player
+    MoveList& possibleMoves = context.moveLists[depth];
+    generateLegalMoves(board, sideToMove, possibleMoves);
+
+    if (possibleMoves.empty()) return evaluateFor(context, board, sideToMove);
+    if (depth == maxDepth) {
+        // At the horizon a pending capture would change the material: play it out first
+        if (context.control->quiescence && possibleMoves.front().captured) {
+            return searchCaptures(context, board, depth, sideToMove, alpha, beta);
+        }
+        return evaluateFor(context, board, sideToMove);
+    }
+
+    // Transposition table: reuse a result searched to exactly this depth. Deeper
+    // results would be stronger, but which of them a thread sees depends on timing,
+    // and fixed-depth scores must not depend on the thread count.
+    int remainingDepth = maxDepth - depth;
+    int originalAlpha = alpha;
+    int originalBeta = beta;
+    TTEntry entry;
+    TranspositionTable& table = *context.control->table;
+    bool hit = table.probe(board.hash, entry);
+    ++context.ttProbes;
+    context.ttHits += hit;
+    if (hit && entry.depth == remainingDepth) {
+        int score = scoreFromTable(entry.score, depth);
+        if (entry.bound == BOUND_LOWER) alpha = max(alpha, score);
+        if (entry.bound == BOUND_UPPER) beta = min(beta, score);
+        if (entry.bound == BOUND_EXACT || alpha >= beta) {
+            ++context.ttCutoffs;
+            return score;
+        }
+    }
+    int side = sideToMove == WHITE ? 0 : 1;
+    orderMoves(context, board, possibleMoves, hit ? &entry : nullptr, depth, side);
+
+    // The children are leaves: score them all at once instead of visiting each
+    bool frontier = depth + 1 == maxDepth;
+    if (frontier) evaluateChildren(context, board, possibleMoves);
+
+    char opponent = opponentOf(sideToMove);
+    int best = -INFINITE_SCORE;
+    const BitMove* bestMove = nullptr;
+
+    for (size_t i = 0; i < possibleMoves.size(); ++i) {
+        const BitMove& move = possibleMoves[i];
+        int value;
+        if (frontier) {
+            value = -frontierValue(context, board, move, context.frontierScores[i], depth + 1, maxDepth, opponent, -beta, -alpha);
+        }
+        else {
+            // Apply the move
+            UndoRecord undo;
+            makeMove(board, move, undo);
+
+            // Recurse: full window for the first move, scout first for the rest
+            if (i == 0 || !context.control->pvs) {
+                value = -negamax(context, board, depth + 1, maxDepth, opponent, -beta, -alpha);
+            }
+            else {
+                value = -negamax(context, board, depth + 1, maxDepth, opponent, -alpha - 1, -alpha);
+                if (value > alpha && value < beta && !context.stopped) {
+                    ++context.researches;
+                    value = -negamax(context, board, depth + 1, maxDepth, opponent, -beta, -alpha);
+                }
+            }
+            unmakeMove(board, undo);
+        }
+        if (context.stopped) return 0;
+
+        if (value > best) {
+            best = value;
+            bestMove = &move;
+        }
+        alpha = max(alpha, best);
+
+        // Alpha Beta Pruning
+        if (alpha >= beta) {
+            ++context.cutoffs;
+            context.firstMoveCutoffs += i == 0;
+            recordCutoff(context, move, depth, remainingDepth, side);
+            break;
+        }
+    }
+
+    // Scores at or outside the original window are only bounds on the true value
+    BoundType bound = BOUND_EXACT;
+    if (best <= originalAlpha) bound = BOUND_UPPER;
+    else if (best >= originalBeta) bound = BOUND_LOWER;
+    table.store(board.hash, scoreToTable(best, depth), remainingDepth, bound, bestMove);
+    ++context.ttStores;
+
+    return best;
+}
+
+// Root moves of one iteration, handed out to the search threads one at a time.
+// Root scores are kept from the point of view of the side to move.
+struct RootSplit {
+    const Bitboard* board;
+    const vector<BitMove>* moves;
+    char sideToMove;
+    int maxDepth;
+    int beta;                     // Upper end of the aspiration window
+    atomic<size_t> nextMove{ 0 };
+    atomic<int> alpha{ -INFINITE_SCORE }; // Best score found so far by any thread (or the window's lower end)
+    atomic<bool> failedHigh{ false };     // A move reached beta: the window was too low
+    mutex bestLock;
+    int bestVal = -INFINITE_SCORE;
+    size_t bestIndex = 0;
+};
+
+// Alpha to search a root move with: the shared alpha, lowered by one when a later
+// move set it, so that a move with an equal score is still found exact and can take
+// the best move back. Single-threaded, alpha always comes from an earlier move.
+static int rootMoveAlpha(RootSplit& split, size_t index) {
+    lock_guard<mutex> lock(split.bestLock);
+    int alpha = split.alpha.load();
+    if (split.bestVal == alpha && split.bestIndex > index) --alpha;
+    return alpha;
+}
+
+// Search one root move with the current shared alpha and publish its score
+static void searchRootMove(SearchContext& context, RootSplit& split, size_t index) {
+    const BitMove& move = (*split.moves)[index];
+    int alpha = rootMoveAlpha(split, index);
+    int beta = split.beta;
+    char opponent = opponentOf(split.sideToMove);
+
+    // Apply the move
+    Bitboard newBoard = applyMove(*split.board, move);
+
+    // The first root move gets the whole window; later ones are scouted like in negamax
+    int moveVal;
+    if (index == 0 || !context.control->pvs) {
+        moveVal = -negamax(context, newBoard, 0, split.maxDepth, opponent, -beta, -alpha);
+    }
+    else {
+        moveVal = -negamax(context, newBoard, 0, split.maxDepth, opponent, -alpha - 1, -alpha);
+        if (moveVal > alpha && moveVal < beta && !context.stopped) {
+            ++context.researches;
+            alpha = max(alpha, rootMoveAlpha(split, index));
+            moveVal = -negamax(context, newBoard, 0, split.maxDepth, opponent, -beta, -alpha);
+        }
+    }
+    if (context.stopped) return;
+
+    lock_guard<mutex> lock(split.bestLock);
+    // A score at or below the alpha it was searched with is only an upper bound.
+    // Equal exact scores go to the earlier move so the choice does not depend on timing.
+    if (moveVal > alpha && (moveVal > split.bestVal || (moveVal == split.bestVal && index < split.bestIndex))) {
+        split.bestVal = moveVal;
+        split.bestIndex = index;
+    }
+    // Update alpha for the top-level call
+    if (moveVal > split.alpha.load()) split.alpha.store(moveVal);
+    if (moveVal >= beta) split.failedHigh.store(true);
+}
+
+// Thread loop: take the next unsearched root move until none are left (or one failed high)
+static void searchRootMoves(SearchContext& context, RootSplit& split) {
+    for (size_t index = split.nextMove++; index < split.moves->size() && !split.failedHigh.load(); index = split.nextMove++) {
+        searchRootMove(context, split, index);
+        if (context.stopped) return;
+    }
+}
+
+// How one root search with a window ended
+enum RootOutcome { ROOT_STOPPED, ROOT_EXACT, ROOT_FAILED_LOW, ROOT_FAILED_HIGH };
+
+// One root search to maxDepth within (alpha, beta); moves are tried in the given order.
+// The first move is searched alone to establish alpha, then the remaining moves
+// are split across one context per thread (root splitting with a shared alpha).
+// bestVal is from the side to move's point of view: exact, or the bound that failed.
+static RootOutcome searchRoot(vector<SearchContext>& contexts, const Bitboard& board, char sideToMove, const vector<BitMove>& possibleMoves,
+                              int maxDepth, int alpha, int beta, BitMove& bestMove, int& bestVal) {
+    RootSplit split;
+    split.board = &board;
+    split.moves = &possibleMoves;
+    split.sideToMove = sideToMove;
+    split.maxDepth = maxDepth;
+    split.beta = beta;
+    split.alpha = alpha;
+
+    searchRootMove(contexts[0], split, split.nextMove++);
+
+    vector<thread> helpers;
+    for (size_t i = 1; i < contexts.size() && !contexts[0].stopped && !split.failedHigh.load(); ++i) {
+        helpers.emplace_back(searchRootMoves, ref(contexts[i]), ref(split));
+    }
+    if (!contexts[0].stopped) searchRootMoves(contexts[0], split);
+    for (auto& helper : helpers) helper.join();
+
+    if (contexts[0].control->stop.load()) return ROOT_STOPPED;
+
+    if (split.failedHigh.load()) {
+        bestVal = split.bestVal;
+        return ROOT_FAILED_HIGH;
+    }
+    if (split.bestVal <= alpha) { // No move beat the window's lower end
+        bestVal = alpha;
+        return ROOT_FAILED_LOW;
+    }
+    bestVal = split.bestVal;
+    bestMove = possibleMoves[split.bestIndex];
+
+    // Inside the window the root score is exact
+    contexts[0].control->table->store(board.hash, bestVal, maxDepth + 1, BOUND_EXACT, &bestMove);
+    ++contexts[0].ttStores;
+    return ROOT_EXACT;
+}
+
+// Search the root with an aspiration window around the previous iteration's score,
+// widening it on the side that failed until the score falls inside.
+// bestVal is from White's point of view.
+// Returns false if the search was stopped before it completed.
+static bool searchIteration(vector<SearchContext>& contexts, const Bitboard& board, char sideToMove, const vector<BitMove>& possibleMoves,
+                            int maxDepth, int previousScore, BitMove& bestMove, int& bestVal) {
+    int delta = ASPIRATION_WINDOW;
+    bool aspirate = contexts[0].control->pvs && maxDepth > 1;
+    int alpha = aspirate ? previousScore - delta : -INFINITE_SCORE;
+    int beta = aspirate ? previousScore + delta : INFINITE_SCORE;
+    for (;;) {
+        int score = 0;
+        RootOutcome outcome = searchRoot(contexts, board, sideToMove, possibleMoves, maxDepth, alpha, beta, bestMove, score);
+        if (outcome == ROOT_STOPPED) return false;
+        if (outcome == ROOT_EXACT) {
+            bestVal = sideToMove == WHITE ? score : -score;
+            return true;
+        }
+        ++contexts[0].aspirationFailures;
+        delta *= ASPIRATION_GROWTH;
+        bool giveUp = delta > ASPIRATION_MAX_WINDOW;
+        if (outcome == ROOT_FAILED_LOW) alpha = giveUp ? -INFINITE_SCORE : max(-INFINITE_SCORE, score - delta);
+        else beta = giveUp ? INFINITE_SCORE : min(INFINITE_SCORE, score + delta);
+    }
+}
+
+// Statistics counters of all threads added up; they count from the start of the search
+static IterationStats sumCounters(const vector<SearchContext>& contexts) {
+    IterationStats sum;
+    for (const auto& context : contexts) {
+        sum.nodes += context.nodes;
+        sum.quiescenceNodes += context.quiescenceNodes;
+        sum.cutoffs += context.cutoffs;
+        sum.firstMoveCutoffs += context.firstMoveCutoffs;
+        sum.ttProbes += context.ttProbes;
+        sum.ttHits += context.ttHits;
+        sum.ttCutoffs += context.ttCutoffs;
+        sum.ttStores += context.ttStores;
+        sum.researches += context.researches;
+        sum.aspirationFailures += context.aspirationFailures;
+    }
+    return sum;
+}
+
+// What one iteration added: the counters after it minus those before it
+static IterationStats iterationDifference(const IterationStats& after, const IterationStats& before) {
+    IterationStats difference;
+    difference.nodes = after.nodes - before.nodes;
+    difference.quiescenceNodes = after.quiescenceNodes - before.quiescenceNodes;
+    difference.cutoffs = after.cutoffs - before.cutoffs;
+    difference.firstMoveCutoffs = after.firstMoveCutoffs - before.firstMoveCutoffs;
+    difference.ttProbes = after.ttProbes - before.ttProbes;
+    difference.ttHits = after.ttHits - before.ttHits;
+    difference.ttCutoffs = after.ttCutoffs - before.ttCutoffs;
+    difference.ttStores = after.ttStores - before.ttStores;
+    difference.researches = after.researches - before.researches;
+    difference.aspirationFailures = after.aspirationFailures - before.aspirationFailures;
+    return difference;
+}
+
+SearchResult findBestMove(const Bitboard& board, char sideToMove, const SearchOptions& options) {
+    int maxDepth = options.maxDepth;
+    int timeLimitMs = options.timeLimitMs;
+    const atomic<bool>* cancel = options.cancel;
+    const SearchProgressCallback& onIteration = options.onIteration;
+    SearchControl control;
+    control.startTime = SearchClock::now();
+    control.cancel = cancel;
+    if (options.table) control.table = options.table;
+    control.weights = options.weights;
+    control.quiescence = options.quiescence;
+    control.pvs = options.pvs;
+    vector<SearchContext> contexts(clamp(options.threads, 1, MAX_SEARCH_THREADS));
+    for (auto& context : contexts) context.control = &control;
+
+    SearchResult result = { { 0, 0, 0 }, false, 0, 0, 0, 0.0 };
+    vector<BitMove> possibleMoves = generateLegalMoves(board, sideToMove);
+    if (possibleMoves.empty()) return result;
+
+    result.bestMove = possibleMoves.front();
+    result.hasMove = true;
+
+    // Opening book: play the stored move without searching
+    BookEntry bookEntry;
+    if (options.useBook && openingBook.size() > 0 && openingBook.probe(board, possibleMoves, result.bestMove, bookEntry)) {
+        result.score = bookEntry.score;
+        result.depth = bookEntry.depth;
+        result.fromBook = true;
+        result.seconds = chrono::duration<double>(SearchClock::now() - control.startTime).count();
+        return result;
+    }
+    TTEntry rootEntry;
+    bool rootHit = control.table->probe(board.hash, rootEntry);
+    orderHashMove(possibleMoves, rootHit ? &rootEntry : nullptr);
+
+    result.iterations.reserve(max(0, min(maxDepth, MAX_SEARCH_DEPTH))); // One allocation, however deep the search goes
+    IterationStats counted; // Counters at the end of the previous iteration
+    double countedSeconds = 0.0;
+    for (int depth = 1; depth <= min(maxDepth, MAX_SEARCH_DEPTH); ++depth) {
+        BitMove iterationMove = possibleMoves.front();
+        int iterationScore = 0;
+        int previousScore = sideToMove == WHITE ? result.score : -result.score;
+        if (!searchIteration(contexts, board, sideToMove, possibleMoves, depth, previousScore, iterationMove, iterationScore)) {
+            break; // Out of time: keep the previous iteration's result
+        }
+
+        result.bestMove = iterationMove;
+        result.score = iterationScore;
+        result.depth = depth;
+        double elapsed = chrono::duration<double>(SearchClock::now() - control.startTime).count();
+        IterationStats totals = sumCounters(contexts);
+        IterationStats iteration = iterationDifference(totals, counted);
+        iteration.depth = depth;
+        iteration.seconds = elapsed - countedSeconds;
+        result.iterations.push_back(iteration);
+        counted = totals;
+        countedSeconds = elapsed;
+        if (onIteration) {
+            SearchResult progress = result;
+            progress.nodes = totals.nodes;
+            progress.quiescenceNodes = totals.quiescenceNodes;
+            progress.seconds = elapsed;
+            onIteration(progress);
+        }
+        if (cancel && cancel->load()) break;
+
+        // Search the previous best move first in the next iteration
+        for (size_t i = 0; i < possibleMoves.size(); ++i) {
+            if (sameMove(possibleMoves[i], iterationMove)) {
+                rotate(possibleMoves.begin(), possibleMoves.begin() + i, possibleMoves.begin() + i + 1);
+                break;
+            }
+        }
+
+        if (timeLimitMs > 0) {
+            // Later iterations only need to be abandoned if they overrun
+            control.hasDeadline = true;
+            control.deadline = control.startTime + chrono::milliseconds(timeLimitMs);
+
+            // The next iteration costs several times this one, so don't start it if it cannot finish
+            if (elapsed * 1000.0 * 2 >= timeLimitMs) break;
+        }
+    }
+
+    IterationStats totals = sumCounters(contexts);
+    result.nodes = totals.nodes;
+    result.quiescenceNodes = totals.quiescenceNodes;
+    result.seconds = chrono::duration<double>(SearchClock::now() - control.startTime).count();
+    return result;
+}
+
+SearchResult findBestMove(const Bitboard& board, char sideToMove, int maxDepth, int timeLimitMs, int threads,
+                          const atomic<bool>* cancel, const SearchProgressCallback& onIteration) {
+    SearchOptions options;
+    options.maxDepth = maxDepth;
+    options.timeLimitMs = timeLimitMs;
+    options.threads = threads;
+    options.cancel = cancel;
+    options.onIteration = onIteration;
+    return findBestMove(board, sideToMove, options);
+}
+
+BitMove findBestMove(const Bitboard& board, int maxDepth) {
+    return findBestMove(board, WHITE, maxDepth, 0).bestMove;
+}
+
+
+// --- Statistics ---
+
+double effectiveBranchingFactor(const SearchResult& result, size_t iteration) {
+    if (iteration == 0 || iteration >= result.iterations.size() || result.iterations[iteration - 1].nodes == 0) return 0.0;
+    return (double)result.iterations[iteration].nodes / result.iterations[iteration - 1].nodes;
+}
+
+// part / whole, or 0 when there is nothing to divide
+static double rate(uint64_t part, uint64_t whole) {
+    return whole > 0 ? (double)part / whole : 0.0;
+}
+
+string searchStatsJson(const SearchResult& result) {
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer),
+             "{\"bestmove\":\"%s\",\"score\":%d,\"depth\":%d,\"book\":%s,\"nodes\":%llu,\"qnodes\":%llu,"
+             "\"seconds\":%.6f,\"nps\":%.0f,\"iterations\":[",
+             result.hasMove ? moveToString(result.bestMove).c_str() : "none", result.score, result.depth,
+             result.fromBook ? "true" : "false", (unsigned long long)result.nodes, (unsigned long long)result.quiescenceNodes,
+             result.seconds, result.nodes / max(result.seconds, 1e-9));
+    string json = buffer;
+    for (size_t i = 0; i < result.iterations.size(); ++i) {
+        const IterationStats& iteration = result.iterations[i];
+        snprintf(buffer, sizeof(buffer),
+                 "%s{\"depth\":%d,\"nodes\":%llu,\"qnodes\":%llu,\"seconds\":%.6f,\"nps\":%.0f,\"ebf\":%.3f,"
+                 "\"cutoffs\":%llu,\"firstMoveCutoffRate\":%.4f,\"ttProbes\":%llu,\"ttHitRate\":%.4f,"
+                 "\"ttCutoffRate\":%.4f,\"ttStores\":%llu,\"ttStoreRate\":%.4f,\"researches\":%llu,\"aspirationFailures\":%d}",
+                 i > 0 ? "," : "", iteration.depth, (unsigned long long)iteration.nodes,
+                 (unsigned long long)iteration.quiescenceNodes, iteration.seconds,
+                 iteration.nodes / max(iteration.seconds, 1e-9), effectiveBranchingFactor(result, i),
+                 (unsigned long long)iteration.cutoffs, rate(iteration.firstMoveCutoffs, iteration.cutoffs),
+                 (unsigned long long)iteration.ttProbes, rate(iteration.ttHits, iteration.ttProbes),
+                 rate(iteration.ttCutoffs, iteration.ttProbes), (unsigned long long)iteration.ttStores,
+                 rate(iteration.ttStores, iteration.nodes), (unsigned long long)iteration.researches,
+                 iteration.aspirationFailures);
+        json += buffer;
+    }
+    return json + "]}";
+}
@@ -0,0 +1,96 @@
+#ifndef CHECKERS_SEARCH_H
+#define CHECKERS_SEARCH_H
+
+#include "board.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Deepest iteration the iterative-deepening driver will start
+const int MAX_SEARCH_DEPTH = 64;
+
+// Most threads one search will start; larger requests are clamped to it
+const int MAX_SEARCH_THREADS = 256;
+
+// Set a shallow search depth for simplicity/speed when no time budget is given
+const int DEFAULT_SEARCH_DEPTH = 5;
+
+// Longest capture sequence the quiescence search can follow: every ply removes a piece
+const int MAX_CAPTURE_PLIES = 24;
+
+// Larger than any evaluation; used as the open ends of the search window
+const int INFINITE_SCORE = 1000000;
+
+// Counters of one completed iteration of iterative deepening, summed over all threads
+struct IterationStats {
+    int depth = 0;
+    uint64_t nodes = 0;            // Searched by this iteration alone, capture search included
+    uint64_t quiescenceNodes = 0;
+    uint64_t cutoffs = 0;          // Interior nodes that failed high (beta cutoffs)
+    uint64_t firstMoveCutoffs = 0; // ... already on their first move
+    uint64_t ttProbes = 0;
+    uint64_t ttHits = 0;           // Probes that found the position stored at any depth
+    uint64_t ttCutoffs = 0;        // Hits that decided the node without searching it
+    uint64_t ttStores = 0;
+    uint64_t researches = 0;       // PVS scouts that had to be searched again with the full window
+    int aspirationFailures = 0;    // Root searches repeated with a wider window
+    double seconds = 0.0;          // Time spent on this iteration
+};
+
+// Result of a (possibly time-limited) search
+struct SearchResult {
+    BitMove bestMove;
+    bool hasMove;   // False when the side to move has no legal moves
+    int score;      // From White's point of view
+    int depth;      // Deepest fully completed iteration
+    uint64_t nodes; // Summed over all threads
+    double seconds;
+    bool fromBook = false; // Played from the opening book; score and depth are the book's
+    uint64_t quiescenceNodes = 0; // Part of nodes searched below the horizon by the capture search
+    std::vector<IterationStats> iterations; // Per-depth breakdown; an unfinished last iteration is only in nodes
+};
+
+// Nodes of an iteration divided by those of the one before: the effective branching
+// factor. 0 for the first iteration.
+double effectiveBranchingFactor(const SearchResult& result, size_t iteration);
+
+// The result and its per-depth statistics as one line of JSON
+std::string searchStatsJson(const SearchResult& result);
+
+// Called after every completed iteration with the result so far
+using SearchProgressCallback = std::function<void(const SearchResult&)>;
+
+class TranspositionTable;
+
+// Everything that configures one search besides the position
+struct SearchOptions {
+    int maxDepth = DEFAULT_SEARCH_DEPTH;
+    int timeLimitMs = 0;                       // <= 0 means no limit
+    int threads = 1;
+    const std::atomic<bool>* cancel = nullptr; // See findBestMove
+    SearchProgressCallback onIteration;
+    TranspositionTable* table = nullptr;       // Null means the global transpositionTable
+    EvalWeights weights;
+    bool useBook = true;                       // Consult the global opening book
+    bool quiescence = true;                    // Play out pending captures before evaluating a leaf
+    bool pvs = true;                           // Principal variation search and aspiration windows
+};
+
+// Iterative deepening: search depth 1, 2, 3, ... until maxDepth or until the time
+// limit runs out, and return the deepest completed iteration. The first iteration
+// always completes so there is a move to play. timeLimitMs <= 0 means no limit.
+// Root moves are split across `threads` threads sharing the transposition table.
+// Positions in the opening book return the book move at once, without searching.
+// Setting *cancel (from any thread) stops the search like the clock does; if that
+// happens during the first iteration, the first legal move is returned at depth 0.
+SearchResult findBestMove(const Bitboard& board, char sideToMove, const SearchOptions& options);
+SearchResult findBestMove(const Bitboard& board, char sideToMove, int maxDepth, int timeLimitMs, int threads = 1,
+                          const std::atomic<bool>* cancel = nullptr, const SearchProgressCallback& onIteration = {});
+
+// Fixed-depth search for White, as used before the time limit existed
+BitMove findBestMove(const Bitboard& board, int maxDepth);
+
+#endif // CHECKERS_SEARCH_H
@@ -0,0 +1,620 @@
+#include "tablebase.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+EndgameTablebases tablebases;
+
+
+// --- Indexing ---
+//
+// A table holds one byte per index for the positions of one material class with
+// the side to move playing "white" (moving up the board). Men and kings are
+// indexed as combinations of squares:
+//   white men among squares 4-31 (a white man on row 0 would be a king),
+//   black men among squares 0-27, independently of the white men,
+//   white kings among the squares left free by the men,
+//   black kings among the squares still free.
+// Indices where a white and a black man share a square are unused.
+//
+// Value bytes: 0 = draw (or unused index), otherwise the distance in plies to the
+// end of the game plus one. Even distances are losses for the side to move, odd
+// distances are wins.
+
+// Longest distance a value byte can hold
+const int MAX_TABLEBASE_PLIES = 254;
+
+// Material classes are keyed by their piece counts in base MAX_TABLEBASE_PIECES + 1
+const int MATERIAL_BASE = MAX_TABLEBASE_PIECES + 1;
+const int MATERIAL_KEYS = MATERIAL_BASE * MATERIAL_BASE * MATERIAL_BASE * MATERIAL_BASE;
+
+static constexpr auto BINOMIAL = [] {
+    array<array<uint64_t, 33>, 33> binomial = {};
+    for (int n = 0; n <= 32; ++n) {
+        binomial[n][0] = 1;
+        for (int k = 1; k <= n; ++k) binomial[n][k] = binomial[n - 1][k - 1] + binomial[n - 1][k];
+    }
+    return binomial;
+}();
+
+static int materialKey(const Material& material) {
+    return ((material.whiteMen * MATERIAL_BASE + material.whiteKings) * MATERIAL_BASE + material.blackMen) * MATERIAL_BASE + material.blackKings;
+}
+
+static Material materialOf(const Bitboard& board) {
+    int whiteKings = popcount(board.white & board.kings);
+    int blackKings = popcount(board.black & board.kings);
+    return { popcount(board.white) - whiteKings, whiteKings, popcount(board.black) - blackKings, blackKings };
+}
+
+// The same class seen from the other side
+static Material mirrored(const Material& material) {
+    return { material.blackMen, material.blackKings, material.whiteMen, material.whiteKings };
+}
+
+// Square s becomes square 31 - s: the board turned around
+static uint32_t reverseSquares(uint32_t mask) {
+    mask = ((mask >> 1) & 0x55555555u) | ((mask & 0x55555555u) << 1);
+    mask = ((mask >> 2) & 0x33333333u) | ((mask & 0x33333333u) << 2);
+    mask = ((mask >> 4) & 0x0F0F0F0Fu) | ((mask & 0x0F0F0F0Fu) << 4);
+    mask = ((mask >> 8) & 0x00FF00FFu) | ((mask & 0x00FF00FFu) << 8);
+    return (mask >> 16) | (mask << 16);
+}
+
+// The position with the side to move playing White (turn the board and swap colours for Black)
+static Bitboard normalized(const Bitboard& board, char sideToMove) {
+    if (sideToMove == WHITE) return board;
+    return { reverseSquares(board.black), reverseSquares(board.white), reverseSquares(board.kings), 0 };
+}
+
+// Colex rank of a set among the sets with the same number of members
+static uint64_t rankSet(uint32_t set) {
+    uint64_t rank = 0;
+    for (int i = 1; set; ++i, set &= set - 1) rank += BINOMIAL[countr_zero(set)][i];
+    return rank;
+}
+
+// The members-element set with the given colex rank
+static uint32_t unrankSet(uint64_t rank, int members) {
+    uint32_t set = 0;
+    for (int i = members; i >= 1; --i) {
+        int element = i - 1;
+        while (BINOMIAL[element + 1][i] <= rank) ++element;
+        rank -= BINOMIAL[element][i];
+        set |= 1u << element;
+    }
+    return set;
+}
+
+// Renumber the squares of set that lie in free as 0, 1, 2, ... in square order
+static uint32_t compressSquares(uint32_t set, uint32_t free) {
+    uint32_t compressed = 0;
+    for (int bit = 0; free; ++bit, free &= free - 1) {
+        if (set & free & (0u - free)) compressed |= 1u << bit;
+    }
+    return compressed;
+}
+
+// Inverse of compressSquares
+static uint32_t expandSquares(uint32_t compressed, uint32_t free) {
+    uint32_t set = 0;
+    for (; free; free &= free - 1, compressed >>= 1) {
+        if (compressed & 1) set |= free & (0u - free);
+    }
+    return set;
+}
+
+// Number of combinations for each piece type of a class
+struct IndexLayout {
+    uint64_t whiteMen, blackMen, whiteKings, blackKings;
+
+    explicit IndexLayout(const Material& material)
+        : whiteMen(BINOMIAL[28][material.whiteMen]),
+          blackMen(BINOMIAL[28][material.blackMen]),
+          whiteKings(BINOMIAL[32 - material.whiteMen - material.blackMen][material.whiteKings]),
+          blackKings(BINOMIAL[32 - material.whiteMen - material.blackMen - material.whiteKings][material.blackKings]) {}
+
+    uint64_t size() const { return whiteMen * blackMen * whiteKings * blackKings; }
+};
+
+// Index of a normalized position (White to move) within its class's table
+static uint64_t encodeIndex(const Bitboard& board, const IndexLayout& layout) {
+    uint32_t whiteMen = board.white & ~board.kings;
+    uint32_t blackMen = board.black & ~board.kings;
+    uint32_t whiteKings = board.white & board.kings;
+    uint32_t free = ~(whiteMen | blackMen);
+    uint64_t index = rankSet(whiteMen >> 4);
+    index = index * layout.blackMen + rankSet(blackMen);
+    index = index * layout.whiteKings + rankSet(compressSquares(whiteKings, free));
+    index = index * layout.blackKings + rankSet(compressSquares(board.black & board.kings, free & ~whiteKings));
+    return index;
+}
+
+// Position of a table index (White to move); false for unused indices
+static bool decodeIndex(uint64_t index, const Material& material, const IndexLayout& layout, Bitboard& board) {
+    uint64_t blackKingsRank = index % layout.blackKings;
+    index /= layout.blackKings;
+    uint64_t whiteKingsRank = index % layout.whiteKings;
+    index /= layout.whiteKings;
+    uint64_t blackMenRank = index % layout.blackMen;
+    uint64_t whiteMenRank = index / layout.blackMen;
+
+    uint32_t whiteMen = unrankSet(whiteMenRank, material.whiteMen) << 4;
+    uint32_t blackMen = unrankSet(blackMenRank, material.blackMen);
+    if (whiteMen & blackMen) return false;
+    uint32_t free = ~(whiteMen | blackMen);
+    uint32_t whiteKings = expandSquares(unrankSet(whiteKingsRank, material.whiteKings), free);
+    uint32_t blackKings = expandSquares(unrankSet(blackKingsRank, material.blackKings), free & ~whiteKings);
+    board = { whiteMen | whiteKings, blackMen | blackKings, whiteKings | blackKings, 0 };
+    return true;
+}
+
+
+// --- Table Files ---
+//
+// A file is a 32-byte header followed by one value byte per index:
+//   "CKTB", format version, the four piece counts, the longest distance in the
+//   table and the number of entries (little-endian).
+
+const char TABLEBASE_MAGIC[4] = { 'C', 'K', 'T', 'B' };
+const uint32_t TABLEBASE_VERSION = 1;
+const size_t TABLEBASE_HEADER_SIZE = 32;
+
+struct TablebaseHeader {
+    char magic[4];
+    uint32_t version;
+    uint8_t pieces[4]; // White men, white kings, black men, black kings
+    uint32_t longestPlies;
+    uint64_t entries;
+    uint8_t reserved[8];
+};
+static_assert(sizeof(TablebaseHeader) == TABLEBASE_HEADER_SIZE, "tablebase header layout");
+
+struct TablebaseFile {
+    Material material;
+    IndexLayout layout;
+    int longestPlies;
+    const uint8_t* values = nullptr;
+#ifdef _WIN32
+    vector<uint8_t> contents; // No mmap: the file is read into memory
+#else
+    void* mapping = nullptr;
+    size_t mappingLength = 0;
+#endif
+
+    TablebaseFile(const Material& material, int longestPlies) : material(material), layout(material), longestPlies(longestPlies) {}
+
+    ~TablebaseFile() {
+#ifndef _WIN32
+        if (mapping) munmap(mapping, mappingLength);
+#endif
+    }
+};
+
+string tablebaseFileName(const Material& material) {
+    char name[32];
+    snprintf(name, sizeof(name), "%d%d%d%d.ctb", material.whiteMen, material.whiteKings, material.blackMen, material.blackKings);
+    return name;
+}
+
+// Map a table file; returns null if it is missing or not a table for this material
+static unique_ptr<TablebaseFile> openTablebaseFile(const string& path, const Material& material) {
+    TablebaseHeader header = {};
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return nullptr;
+    bool valid = fread(&header, sizeof(header), 1, file) == 1
+              && memcmp(header.magic, TABLEBASE_MAGIC, sizeof(header.magic)) == 0
+              && header.version == TABLEBASE_VERSION
+              && header.pieces[0] == material.whiteMen && header.pieces[1] == material.whiteKings
+              && header.pieces[2] == material.blackMen && header.pieces[3] == material.blackKings
+              && header.entries == IndexLayout(material).size();
+    auto table = make_unique<TablebaseFile>(material, (int)header.longestPlies);
+
+#ifdef _WIN32
+    if (valid) {
+        table->contents.resize(header.entries);
+        valid = fread(table->contents.data(), 1, header.entries, file) == header.entries;
+        table->values = table->contents.data();
+    }
+    fclose(file);
+#else
+    fclose(file);
+    if (valid) {
+        int descriptor = open(path.c_str(), O_RDONLY);
+        struct stat status;
+        valid = descriptor >= 0 && fstat(descriptor, &status) == 0
+             && (uint64_t)status.st_size == TABLEBASE_HEADER_SIZE + header.entries;
+        if (valid) {
+            table->mappingLength = status.st_size;
+            void* mapping = mmap(nullptr, table->mappingLength, PROT_READ, MAP_SHARED, descriptor, 0);
+            valid = mapping != MAP_FAILED;
+            if (valid) {
+                table->mapping = mapping;
+                table->values = (const uint8_t*)mapping + TABLEBASE_HEADER_SIZE;
+            }
+        }
+        if (descriptor >= 0) close(descriptor); // The mapping stays valid
+    }
+#endif
+    return valid ? move(table) : nullptr;
+}
+
+// Write a finished table to a temporary file and rename it, so a table file is
+// either complete or absent even if the generator is killed
+static bool writeTablebaseFile(const string& path, const Material& material, const vector<uint8_t>& values, int longestPlies) {
+    TablebaseHeader header = {};
+    memcpy(header.magic, TABLEBASE_MAGIC, sizeof(header.magic));
+    header.version = TABLEBASE_VERSION;
+    header.pieces[0] = (uint8_t)material.whiteMen;
+    header.pieces[1] = (uint8_t)material.whiteKings;
+    header.pieces[2] = (uint8_t)material.blackMen;
+    header.pieces[3] = (uint8_t)material.blackKings;
+    header.longestPlies = (uint32_t)longestPlies;
+    header.entries = values.size();
+
+    string temporaryPath = path + ".tmp";
+    FILE* file = fopen(temporaryPath.c_str(), "wb");
+    if (!file) return false;
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+                && fwrite(values.data(), 1, values.size(), file) == values.size();
+    written = fclose(file) == 0 && written;
+    error_code renameError;
+    if (written) filesystem::rename(temporaryPath, path, renameError);
+    return written && !renameError;
+}
+
+
+// --- Probing ---
+
+EndgameTablebases::EndgameTablebases() : byMaterial(MATERIAL_KEYS, nullptr) {}
+
+EndgameTablebases::~EndgameTablebases() = default;
+
+// Every material class with at least one piece per side and at most maxPieces pieces
+static vector<Material> materialClasses(int maxPieces) {
+    vector<Material> classes;
+    for (int pieces = 2; pieces <= maxPieces; ++pieces) {
+        for (int whiteMen = 0; whiteMen <= pieces; ++whiteMen)
+            for (int whiteKings = 0; whiteMen + whiteKings <= pieces; ++whiteKings)
+                for (int blackMen = 0; whiteMen + whiteKings + blackMen <= pieces; ++blackMen) {
+                    Material material = { whiteMen, whiteKings, blackMen, pieces - whiteMen - whiteKings - blackMen };
+                    if (whiteMen + whiteKings > 0 && material.blackMen + material.blackKings > 0) classes.push_back(material);
+                }
+    }
+    return classes;
+}
+
+int EndgameTablebases::load(const string& directory) {
+    unload();
+    for (const Material& material : materialClasses(MAX_TABLEBASE_PIECES)) {
+        unique_ptr<TablebaseFile> table = openTablebaseFile((filesystem::path(directory) / tablebaseFileName(material)).string(), material);
+        if (!table) continue;
+        byMaterial[materialKey(material)] = table.get();
+        pieceLimit = max(pieceLimit, material.pieces());
+        tables.push_back(move(table));
+    }
+    return (int)tables.size();
+}
+
+void EndgameTablebases::unload() {
+    fill(byMaterial.begin(), byMaterial.end(), nullptr);
+    tables.clear();
+    pieceLimit = 0;
+}
+
+bool EndgameTablebases::probe(const Bitboard& board, char sideToMove, TablebaseOutcome& outcome, int& plies) const {
+    Bitboard position = normalized(board, sideToMove);
+    Material material = materialOf(position);
+    if (material.pieces() > pieceLimit || material.blackMen + material.blackKings == 0 || material.whiteMen + material.whiteKings == 0) return false;
+    const TablebaseFile* table = byMaterial[materialKey(material)];
+    if (!table) return false;
+
+    uint8_t value = table->values[encodeIndex(position, table->layout)];
+    plies = value == 0 ? 0 : value - 1;
+    outcome = value == 0 ? TB_DRAW : plies % 2 ? TB_WIN : TB_LOSS;
+    return true;
+}
+
+
+// --- Generation ---
+//
+// Retrograde analysis, one pass per distance. Pass 0 marks the positions without a
+// move as lost. Pass p resolves the positions at distance p: a position is won if
+// a move reaches a position lost at distance p - 1, and lost if every move reaches
+// a won position and the longest of those wins has distance p - 1. Inside a class
+// only simple moves (no capture, no promotion) lead to the mirror class, so the
+// candidates for pass p are the predecessors, by an "unmove", of the positions
+// resolved in pass p - 1. Moves into finished tables are looked at once up front:
+// their values are known, so they only fix the pass at which the position has to
+// be looked at again.
+
+// Number of indices a generator thread claims at a time
+const uint64_t GENERATION_CHUNK = 1 << 14;
+
+// Tables visible to the generator: finished ones are mapped from disk, the ones
+// being built live in memory and are read and written with relaxed atomics
+struct GenerationTables {
+    vector<uint8_t*> values = vector<uint8_t*>(MATERIAL_KEYS, nullptr);
+    vector<const IndexLayout*> layouts = vector<const IndexLayout*>(MATERIAL_KEYS, nullptr);
+
+    // Value byte of a position with White (the side to move) to move
+    uint8_t lookup(const Bitboard& position, const Material& material) const {
+        if (material.whiteMen + material.whiteKings == 0) return 1; // No pieces: lost now
+        int key = materialKey(material);
+        return atomic_ref<uint8_t>(values[key][encodeIndex(position, *layouts[key])]).load(memory_order_relaxed);
+    }
+};
+
+// A table being built
+struct GenerationTable {
+    Material material;
+    IndexLayout layout;
+    vector<uint8_t> values;
+    vector<uint8_t> triggers;         // Pass at which a move into a finished table decides the position, 0 if none
+    GenerationTable* mirror = nullptr; // Table of the positions after a simple move (may be this one)
+
+    explicit GenerationTable(const Material& material)
+        : material(material), layout(material), values(layout.size(), 0), triggers(layout.size(), 0) {}
+};
+
+// Look at every move of an open position and store its value if the positions
+// resolved before `pass` decide it. Returns true if this call stored the value.
+static bool resolvePosition(GenerationTable& table, uint64_t index, const Bitboard& board, const GenerationTables& lookups,
+                            int pass, vector<BitMove>& moves) {
+    atomic_ref<uint8_t> value(table.values[index]);
+    if (value.load(memory_order_relaxed) != 0) return false;
+
+    generateLegalMoves(board, WHITE, moves);
+    bool won = false;
+    bool allWon = true; // Every reply resolved as a win for the opponent
+    for (const BitMove& move : moves) {
+        Bitboard reply = normalized(applyMove(board, move), BLACK);
+        uint8_t replyValue = lookups.lookup(reply, materialOf(reply));
+        if (replyValue == 0 || replyValue - 1 >= pass) {
+            allWon = false;
+            continue;
+        }
+        if ((replyValue - 1) % 2 == 0) {
+            won = true;
+            break;
+        }
+    }
+    if (!won && !allWon) return false;
+    uint8_t open = 0;
+    return value.compare_exchange_strong(open, (uint8_t)(pass + 1), memory_order_relaxed);
+}
+
+// Pass 0: lose the positions without a move, and set the trigger pass of those with
+// moves into finished tables: one more than the shortest lost reply there (a win),
+// or else one more than the longest won reply there (the earliest possible loss).
+// Returns the number of positions lost; maxTrigger is raised to the latest trigger.
+static uint64_t initializeTable(GenerationTable& table, const GenerationTables& lookups, uint64_t start, uint64_t end,
+                                vector<BitMove>& moves, int& maxTrigger) {
+    uint64_t lost = 0;
+    Material inClass = table.mirror->material;
+    for (uint64_t index = start; index < end; ++index) {
+        Bitboard board;
+        if (!decodeIndex(index, table.material, table.layout, board)) continue;
+        generateLegalMoves(board, WHITE, moves);
+        if (moves.empty()) {
+            table.values[index] = 1;
+            ++lost;
+            continue;
+        }
+
+        int shortestLoss = MAX_TABLEBASE_PLIES + 1;
+        int longestWin = -1;
+        for (const BitMove& move : moves) {
+            Bitboard reply = normalized(applyMove(board, move), BLACK);
+            Material material = materialOf(reply);
+            if (materialKey(material) == materialKey(inClass)) continue;
+            uint8_t replyValue = lookups.lookup(reply, material);
+            if (replyValue == 0) continue;
+            if ((replyValue - 1) % 2 == 0) shortestLoss = min(shortestLoss, replyValue - 1);
+            else longestWin = max(longestWin, replyValue - 1);
+        }
+        int trigger = shortestLoss <= MAX_TABLEBASE_PLIES ? shortestLoss + 1 : longestWin + 1;
+        if (trigger > 0 && trigger <= MAX_TABLEBASE_PLIES) {
+            table.triggers[index] = (uint8_t)trigger;
+            maxTrigger = max(maxTrigger, trigger);
+        }
+    }
+    return lost;
+}
+
+// Resolve the predecessors of a position just resolved: the positions (in the mirror
+// table) from which the opponent reached it with a simple move
+static uint64_t resolvePredecessors(GenerationTable& table, const Bitboard& board, const GenerationTables& lookups,
+                                    int pass, vector<BitMove>& moves) {
+    uint64_t resolved = 0;
+    uint32_t empty = ~(board.white | board.black);
+    for (uint32_t pieces = board.black; pieces; pieces &= pieces - 1) {
+        int to = countr_zero(pieces);
+        uint32_t toBit = 1u << to;
+        bool isKing = board.kings & toBit;
+        for (int rowDir : { -1, 1 }) {
+            if (!isKing && rowDir == 1) continue; // Black men move down the board, so they came from above
+            for (int colDir : { -1, 1 }) {
+                int from = neighborSquare(to, rowDir, colDir);
+                if (from < 0 || !((empty >> from) & 1u)) continue;
+                uint32_t fromBit = 1u << from;
+                Bitboard previous = { board.white, (board.black & ~toBit) | fromBit, isKing ? (board.kings & ~toBit) | fromBit : board.kings, 0 };
+
+                // With a capture on the board the simple move was not legal
+                generateLegalMoves(previous, BLACK, moves);
+                if (moves.empty() || moves.front().captured) continue;
+
+                Bitboard predecessor = normalized(previous, BLACK);
+                GenerationTable& mirror = *table.mirror;
+                if (resolvePosition(mirror, encodeIndex(predecessor, mirror.layout), predecessor, lookups, pass, moves)) ++resolved;
+            }
+        }
+    }
+    return resolved;
+}
+
+// Run one pass over every table of the group; returns the number of positions resolved
+static uint64_t runGenerationPass(vector<unique_ptr<GenerationTable>>& group, const GenerationTables& lookups, int pass,
+                                  int threads, int& maxTrigger) {
+    atomic<uint64_t> nextChunk{ 0 };
+    atomic<uint64_t> resolved{ 0 };
+    atomic<int> latestTrigger{ maxTrigger };
+    uint64_t totalChunks = 0;
+    for (auto& table : group) totalChunks += (table->values.size() + GENERATION_CHUNK - 1) / GENERATION_CHUNK;
+
+    auto worker = [&]() {
+        vector<BitMove> moves;
+        moves.reserve(64);
+        uint64_t count = 0;
+        int trigger = 0;
+        for (uint64_t chunk = nextChunk++; chunk < totalChunks; chunk = nextChunk++) {
+            // Chunks are numbered through the tables one after the other
+            size_t t = 0;
+            uint64_t tableChunks;
+            while (chunk >= (tableChunks = (group[t]->values.size() + GENERATION_CHUNK - 1) / GENERATION_CHUNK)) {
+                chunk -= tableChunks;
+                ++t;
+            }
+            GenerationTable& table = *group[t];
+            uint64_t offset = chunk * GENERATION_CHUNK;
+            uint64_t end = min<uint64_t>(table.values.size(), offset + GENERATION_CHUNK);
+
+            if (pass == 0) {
+                count += initializeTable(table, lookups, offset, end, moves, trigger);
+                continue;
+            }
+            for (uint64_t index = offset; index < end; ++index) {
+                uint8_t value = atomic_ref<uint8_t>(table.values[index]).load(memory_order_relaxed);
+                bool resolvedLastPass = value == pass;
+                bool triggered = value == 0 && table.triggers[index] == pass;
+                if (!resolvedLastPass && !triggered) continue;
+
+                Bitboard board;
+                decodeIndex(index, table.material, table.layout, board);
+                if (resolvedLastPass) count += resolvePredecessors(table, board, lookups, pass, moves);
+                else if (resolvePosition(table, index, board, lookups, pass, moves)) ++count;
+            }
+        }
+        resolved += count;
+        int latest = latestTrigger.load();
+        while (trigger > latest && !latestTrigger.compare_exchange_weak(latest, trigger)) {}
+    };
+
+    vector<thread> helpers;
+    for (int i = 1; i < threads; ++i) helpers.emplace_back(worker);
+    worker();
+    for (auto& helper : helpers) helper.join();
+    maxTrigger = latestTrigger.load();
+    return resolved.load();
+}
+
+bool generateTablebases(const string& directory, int maxPieces, int threads,
+                        const TablebaseProgressCallback& onTable, string& error) {
+    maxPieces = min(maxPieces, MAX_TABLEBASE_PIECES);
+    threads = max(1, threads);
+    error_code directoryError;
+    filesystem::create_directories(directory, directoryError);
+    if (directoryError) {
+        error = "cannot create " + directory + ": " + directoryError.message();
+        return false;
+    }
+
+    // Captures lead to classes with fewer pieces and promotions to classes with fewer
+    // men, so building in that order means every reply is in a finished table or in
+    // the class itself. A class and its mirror image refer to each other (every move
+    // changes the side to move) and are built together.
+    vector<Material> classes = materialClasses(maxPieces);
+    stable_sort(classes.begin(), classes.end(), [](const Material& a, const Material& b) {
+        if (a.pieces() != b.pieces()) return a.pieces() < b.pieces();
+        return a.whiteMen + a.blackMen < b.whiteMen + b.blackMen;
+    });
+
+    GenerationTables lookups;
+    vector<unique_ptr<TablebaseFile>> finished;
+
+    for (const Material& material : classes) {
+        Material mirror = mirrored(material);
+        if (materialKey(mirror) < materialKey(material)) continue; // Built with its mirror
+        vector<Material> group = { material };
+        if (materialKey(mirror) != materialKey(material)) group.push_back(mirror);
+
+        auto startTime = chrono::steady_clock::now();
+        vector<unique_ptr<TablebaseFile>> existing;
+        for (const Material& member : group) {
+            auto table = openTablebaseFile((filesystem::path(directory) / tablebaseFileName(member)).string(), member);
+            if (table) existing.push_back(move(table));
+        }
+
+        int passes = 0;
+        vector<unique_ptr<GenerationTable>> building;
+        if (existing.size() != group.size()) {
+            existing.clear();
+            for (const Material& member : group) {
+                building.push_back(make_unique<GenerationTable>(member));
+                int key = materialKey(member);
+                lookups.values[key] = building.back()->values.data();
+                lookups.layouts[key] = &building.back()->layout;
+            }
+            building.front()->mirror = building.back().get();
+            building.back()->mirror = building.front().get();
+
+            // After a pass that resolves nothing only triggers can resolve more
+            int maxTrigger = 0;
+            for (int pass = 0; pass <= MAX_TABLEBASE_PLIES; ++pass) {
+                uint64_t resolved = runGenerationPass(building, lookups, pass, threads, maxTrigger);
+                passes = pass + 1;
+                if (resolved == 0 && pass >= maxTrigger) break;
+            }
+
+            for (auto& table : building) {
+                int longest = 0;
+                for (uint8_t value : table->values) longest = max(longest, value - 1);
+                string path = (filesystem::path(directory) / tablebaseFileName(table->material)).string();
+                if (!writeTablebaseFile(path, table->material, table->values, longest)) {
+                    error = "cannot write " + path;
+                    return false;
+                }
+                auto written = openTablebaseFile(path, table->material);
+                if (!written) {
+                    error = "cannot map " + path;
+                    return false;
+                }
+                existing.push_back(move(written));
+            }
+        }
+
+        // Replace the in-memory tables by their mapped files
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+        for (auto& table : existing) {
+            int key = materialKey(table->material);
+            lookups.values[key] = const_cast<uint8_t*>(table->values); // Only read from now on
+            lookups.layouts[key] = &table->layout;
+
+            if (onTable) {
+                TablebaseProgress progress = { table->material, table->layout.size(), 0, 0, table->longestPlies, passes, seconds, building.empty() };
+                for (uint64_t i = 0; i < table->layout.size(); ++i) {
+                    uint8_t value = table->values[i];
+                    if (value) ++((value - 1) % 2 ? progress.wins : progress.losses);
+                }
+                onTable(progress);
+            }
+            finished.push_back(move(table));
+        }
+    }
+    return true;
+}
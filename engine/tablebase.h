@@ -0,0 +1,89 @@
+#ifndef CHECKERS_TABLEBASE_H
+#define CHECKERS_TABLEBASE_H
+
+#include "board.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Most pieces (both sides together) a tablebase can hold
+const int MAX_TABLEBASE_PIECES = 8;
+
+// Score of a tablebase win at the root; one less for every ply until the game ends
+const int TABLEBASE_WIN_SCORE = 100000;
+
+// Game-theoretic value of a position for the side to move
+enum TablebaseOutcome { TB_LOSS = -1, TB_DRAW = 0, TB_WIN = 1 };
+
+// Piece counts of one table. Tables are stored for the side to move only, so
+// "white" here means the side to move; Black-to-move positions are probed
+// through the colour-flipped board.
+struct Material {
+    int whiteMen;
+    int whiteKings;
+    int blackMen;
+    int blackKings;
+
+    int pieces() const { return whiteMen + whiteKings + blackMen + blackKings; }
+};
+
+// Table file name for a material class, e.g. "2101.ctb" for 2 men and a king against a king
+std::string tablebaseFileName(const Material& material);
+
+// One mapped table file (defined in tablebase.cpp)
+struct TablebaseFile;
+
+// Memory-mapped win/loss/draw tables with the distance to the end of the game.
+// Loading only maps the files; pages are read from disk as positions are probed.
+class EndgameTablebases {
+public:
+    EndgameTablebases();
+    ~EndgameTablebases();
+
+    // Map every table file found in directory; returns the number of tables mapped
+    int load(const std::string& directory);
+    void unload();
+
+    // Largest piece count of any mapped table, 0 when none are mapped
+    int maxPieces() const { return pieceLimit; }
+
+    // Look up a position; returns false if no table covers its material.
+    // plies is the number of plies until the side that is losing has no move left
+    // (with best play: the winner wins fast, the loser holds out). 0 for draws.
+    bool probe(const Bitboard& board, char sideToMove, TablebaseOutcome& outcome, int& plies) const;
+
+private:
+    std::vector<std::unique_ptr<TablebaseFile>> tables;
+    std::vector<const TablebaseFile*> byMaterial; // Indexed by material key
+    int pieceLimit = 0;
+};
+
+// Tables used by the search, empty until load() is called
+extern EndgameTablebases tablebases;
+
+// Reported by generateTablebases after every table
+struct TablebaseProgress {
+    Material material;
+    uint64_t positions;   // Index entries, including unreachable ones
+    uint64_t wins;
+    uint64_t losses;
+    int longestPlies;     // Longest distance to the end of the game
+    int passes;
+    double seconds;
+    bool resumed;         // Already on disk from an earlier run
+};
+
+using TablebaseProgressCallback = std::function<void(const TablebaseProgress&)>;
+
+// Build every table with up to maxPieces pieces into directory by retrograde
+// iteration, using `threads` threads per pass. Tables are built smallest first and
+// each is written atomically, so an interrupted run resumes with the first table
+// that is missing. Returns false (with a message in error) if a file cannot be written.
+bool generateTablebases(const std::string& directory, int maxPieces, int threads,
+                        const TablebaseProgressCallback& onTable, std::string& error);
+
+#endif // CHECKERS_TABLEBASE_H
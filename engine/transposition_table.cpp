@@ -0,0 +1,3 @@
+#include "transposition_table.h"
+
+TranspositionTable transpositionTable;
@@ -0,0 +1,108 @@
+#ifndef CHECKERS_TRANSPOSITION_TABLE_H
+#define CHECKERS_TRANSPOSITION_TABLE_H
+
+#include "board.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// How a stored score relates to the true value of the position
+enum BoundType : uint8_t { BOUND_EXACT, BOUND_LOWER, BOUND_UPPER };
+
+// Unpacked table entry as returned by probe()
+struct TTEntry {
+    int score;        // From the side to move's point of view, like negamax; tablebase results count plies from this position
+    int depth;        // Remaining search depth the score was computed with
+    BoundType bound;
+    bool hasMove;     // Whether bestMove is set
+    BitMove bestMove; // Only the start and end squares are stored
+};
+
+// Fixed-size hash table indexed by the low bits of the Zobrist key, shared by all
+// search threads without locks. Each slot packs its entry into one 64-bit word and
+// stores the key XOR-ed with that word, so a slot torn by two concurrent writers
+// simply fails the key check instead of returning mixed data.
+class TranspositionTable {
+public:
+    // Reallocate the table to use at most sizeMB megabytes (rounded down to a power of two entries)
+    void resize(size_t sizeMB) {
+        size_t maxEntries = std::max<size_t>(1, sizeMB * 1024 * 1024 / sizeof(Slot));
+        size_t count = 1;
+        while (count * 2 <= maxEntries) count *= 2;
+        entries.reset(new Slot[count]);
+        entryCount = count;
+        clear();
+    }
+
+    void clear() {
+        for (size_t i = 0; i < entryCount; ++i) {
+            entries[i].check.store(0, std::memory_order_relaxed);
+            entries[i].data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Returns false if the slot holds another position (or a torn write)
+    bool probe(uint64_t key, TTEntry& entry) const {
+        if (entryCount == 0) return false;
+        const Slot& slot = entries[key & (entryCount - 1)];
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if ((slot.check.load(std::memory_order_relaxed) ^ data) != key || data == 0) return false;
+
+        entry.score = (int32_t)(uint32_t)data;
+        entry.depth = (int)((data >> 32) & 0xFF);
+        entry.bound = (BoundType)((data >> 40) & 0x3);
+        entry.hasMove = (data >> 42) & 1;
+        entry.bestMove = { (uint8_t)((data >> 43) & 0x1F), (uint8_t)((data >> 48) & 0x1F), 0 };
+        return true;
+    }
+
+    // Depth-preferred replacement: keep a deeper result for the same position
+    void store(uint64_t key, int score, int depth, BoundType bound, const BitMove* bestMove) {
+        if (entryCount == 0) return;
+        Slot& slot = entries[key & (entryCount - 1)];
+        TTEntry existing;
+        if (probe(key, existing) && existing.depth > depth) return;
+
+        uint64_t data = (uint64_t)(uint32_t)score
+                      | (uint64_t)(depth & 0xFF) << 32
+                      | (uint64_t)bound << 40
+                      | (uint64_t)(bestMove != nullptr) << 42
+                      | (uint64_t)(bestMove ? bestMove->from : 0) << 43
+                      | (uint64_t)(bestMove ? bestMove->to : 0) << 48
+                      | 1ull << 63; // Never zero, so empty entries don't match
+        slot.check.store(key ^ data, std::memory_order_relaxed);
+        slot.data.store(data, std::memory_order_relaxed);
+    }
+
+    size_t sizeBytes() const {
+        return entryCount * sizeof(Slot);
+    }
+
+    // Occupied slots per thousand, sampled from the start of the table
+    int usagePermille() const {
+        size_t sample = std::min<size_t>(entryCount, 1 << 16);
+        size_t used = 0;
+        for (size_t i = 0; i < sample; ++i) used += entries[i].data.load(std::memory_order_relaxed) != 0;
+        return sample == 0 ? 0 : (int)(used * 1000 / sample);
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check; // key ^ data
+        std::atomic<uint64_t> data;
+    };
+
+    std::unique_ptr<Slot[]> entries;
+    size_t entryCount = 0;
+};
+
+// Default table budget, overridable with --hash on the command line
+const size_t DEFAULT_HASH_MB = 64;
+
+// Shared by every search; kept between moves so later searches reuse earlier work
+extern TranspositionTable transpositionTable;
+
+#endif // CHECKERS_TRANSPOSITION_TABLE_H
@@ -5,324 +5,88 @@
 #include <QWidget>
 #include <QLabel>
 #include <QMessageBox>
+#include <QCommandLineParser>
+#include <QCloseEvent>
+#include <QKeyEvent>
+#include <QThread>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <atomic>
 #include <vector>
-#include <limits>
+#include <algorithm>
 #include <string>
 #include <cmath> // Required for abs()
 #include <QDebug> // Required for qDebug()
 
-using namespace std;
-
-// Define pieces
-const char WHITE_PIECE = 'w';
-const char WHITE_KING = 'W';
-const char BLACK_PIECE = 'b';
-const char BLACK_KING = 'B';
-const char EMPTY_SQUARE = ' ';
-
-// Define players
-const char WHITE = 'W'; // AI is White
-const char BLACK = 'B'; // Human is Black
-
-// Structure to represent a move
-struct Move {
-    int startRow, startCol;
-    int endRow, endCol;
-    bool isCapture; // Indicates if this move is a capture
-    vector<pair<int, int>> capturedPieces; // Coordinates of captured pieces
-};
-
-// Structure to represent a single square's coordinates
-struct Square {
-    int row, col;
-};
-
-// --- Simplified Checkers Logic ---
-
-// Basic board representation (8x8, but only dark squares are playable)
-using CheckersBoard = vector<vector<char>>;
-
-// Function to initialize a standard Checkers starting board
-CheckersBoard initializeBoard() {
-    CheckersBoard board(8, vector<char>(8, EMPTY_SQUARE));
-
-    // Place Black pieces
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 8; ++j) {
-            if ((i + j) % 2 != 0) { // Only place on dark squares
-                board[i][j] = BLACK_PIECE;
-            }
-        }
-    }
-
-    // Place White pieces
-    for (int i = 5; i < 8; ++i) {
-        for (int j = 0; j < 8; ++j) {
-            if ((i + j) % 2 != 0) { // Only place on dark squares
-                board[i][j] = WHITE_PIECE;
-            }
-        }
-    }
-
-    return board;
-}
-
-// Helper function to check if a square is on the board and is a dark square
-bool isValidSquare(int row, int col) {
-    return row >= 0 && row < 8 && col >= 0 && col < 8 && (row + col) % 2 != 0;
-}
-
-// Simplified function to check if a move is valid (basic movement and capture)
-// This does NOT fully implement all Checkers rules (e.g., mandatory multi-jumps)
-bool isValidMove(const CheckersBoard& board, const Move& move, char currentPlayer) {
-    // Check if start and end squares are valid dark squares
-    if (!isValidSquare(move.startRow, move.startCol) || !isValidSquare(move.endRow, move.endCol)) {
-        return false;
-    }
-
-    char piece = board[move.startRow][move.startCol];
-    char targetPiece = board[move.endRow][move.endCol];
-
-    // Check if the piece belongs to the current player
-    bool isCurrentPlayerPiece = false;
-    if (currentPlayer == WHITE) {
-        if (piece == WHITE_PIECE || piece == WHITE_KING) isCurrentPlayerPiece = true;
-    }
-    else { // Black player
-        if (piece == BLACK_PIECE || piece == BLACK_KING) isCurrentPlayerPiece = true;
-    }
-    if (!isCurrentPlayerPiece) return false;
-
-    // Cannot move to a non-empty square
-    if (targetPiece != EMPTY_SQUARE) return false;
-
-    int rowDiff = move.endRow - move.startRow;
-    int colDiff = move.endCol - move.startCol;
-
-    // --- Basic Movement and Capture Logic (Simplified) ---
-
-    // Regular piece movement (one step diagonally forward)
-    if (piece == WHITE_PIECE) {
-        if (rowDiff == -1 && abs(colDiff) == 1) return true;
-    }
-    else if (piece == BLACK_PIECE) {
-        if (rowDiff == 1 && abs(colDiff) == 1) return true;
-    }
-
-    // King movement (one step diagonally in any direction)
-    if (piece == WHITE_KING || piece == BLACK_KING) {
-        if (abs(rowDiff) == 1 && abs(colDiff) == 1) return true;
-    }
-
-    // Basic Capture (jumping over one opponent piece)
-    if (abs(rowDiff) == 2 && abs(colDiff) == 2) {
-        int jumpedRow = move.startRow + rowDiff / 2;
-        int jumpedCol = move.startCol + colDiff / 2;
-
-        if (isValidSquare(jumpedRow, jumpedCol)) {
-            char jumpedPiece = board[jumpedRow][jumpedCol];
-            // Check if the jumped piece is an opponent's piece
-            if (currentPlayer == WHITE) {
-                if (jumpedPiece == BLACK_PIECE || jumpedPiece == BLACK_KING) return true;
-            }
-            else { // Black player
-                if (jumpedPiece == WHITE_PIECE || jumpedPiece == WHITE_KING) return true;
-            }
-        }
-    }
-
-    // If none of the above, the move is not valid in this simplified model
-    return false;
-}
-
-// Function to generate all possible legal moves for the current player (simplified)
-vector<Move> generateLegalMoves(const CheckersBoard& board, char currentPlayer) {
-    vector<Move> legalMoves;
-    vector<Move> captureMoves; // Prioritize capture moves
-
-    for (int startRow = 0; startRow < 8; ++startRow) {
-        for (int startCol = 0; startCol < 8; ++startCol) {
-            if (!isValidSquare(startRow, startCol)) continue;
-
-            char piece = board[startRow][startCol];
-            bool isCurrentPlayerPiece = false;
-            if (currentPlayer == WHITE) {
-                if (piece == WHITE_PIECE || piece == WHITE_KING) isCurrentPlayerPiece = true;
-            }
-            else { // Black player
-                if (piece == BLACK_PIECE || piece == BLACK_KING) isCurrentPlayerPiece = true;
-            }
-            if (!isCurrentPlayerPiece) continue;
-
-            // Check possible diagonal moves (1 or 2 steps for captures)
-            int rowDirections[] = { -1, 1 };
-            int colDirections[] = { -1, 1 };
-
-            for (int rowDir : rowDirections) {
-                for (int colDir : colDirections) {
-                    // Check for single step moves
-                    int endRow = startRow + rowDir;
-                    int endCol = startCol + colDir;
-                    Move singleStepMove = { startRow, startCol, endRow, endCol, false, {} };
-                    if (isValidMove(board, singleStepMove, currentPlayer)) {
-                        // Regular pieces can only move forward
-                        if ((piece == WHITE_PIECE && rowDir == -1) || (piece == BLACK_PIECE && rowDir == 1) || piece == WHITE_KING || piece == BLACK_KING) {
-                            legalMoves.push_back(singleStepMove);
-                        }
-                    }
-
-                    // Check for capture moves (two steps)
-                    endRow = startRow + rowDir * 2;
-                    endCol = startCol + colDir * 2;
-                    Move captureMove = { startRow, startCol, endRow, endCol, true, {} };
-                    if (isValidMove(board, captureMove, currentPlayer)) {
-                        int jumpedRow = startRow + rowDir;
-                        int jumpedCol = startCol + colDir;
-                        captureMove.capturedPieces.push_back({ jumpedRow, jumpedCol });
-                        captureMoves.push_back(captureMove);
-                    }
-                }
-            }
-        }
-    }
+#include "board.h"
+#include "game_log.h"
+#include "opening_book.h"
+#include "search.h"
+#include "tablebase.h"
+#include "transposition_table.h"
 
-    // In Checkers, captures are mandatory. If capture moves exist, only return those.
-    if (!captureMoves.empty()) {
-        qDebug() << "Generated capture moves for" << currentPlayer << ":" << captureMoves.size();
-        return captureMoves;
-    }
-
-    qDebug() << "Generated legal moves for" << currentPlayer << ":" << legalMoves.size();
-    return legalMoves;
-}
+using namespace std;
 
+// Depth of the quick search that predicts the human's reply when the table has no move for it
+const int PONDER_PREDICTION_DEPTH = 4;
 
-// Simplified evaluation function (based on piece count and king count)
-// Positive value favors White (AI), negative favors Black (Human)
-int evaluateBoard(const CheckersBoard& board) {
-    int score = 0;
-    for (int i = 0; i < 8; ++i) {
-        for (int j = 0; j < 8; ++j) {
-            if (board[i][j] == WHITE_PIECE) score += 1;
-            else if (board[i][j] == WHITE_KING) score += 3; // Kings are more valuable
-            else if (board[i][j] == BLACK_PIECE) score -= 1;
-            else if (board[i][j] == BLACK_KING) score -= 3; // Kings are more valuable
-        }
-    }
-    return score;
-}
+Q_DECLARE_METATYPE(SearchResult)
 
-// Function to apply a move to the board
-CheckersBoard applyMove(const CheckersBoard& board, const Move& move) {
-    CheckersBoard newBoard = board;
-    char movedPiece = newBoard[move.startRow][move.startCol];
+// --- AI Search Thread ---
 
-    // Move the piece
-    newBoard[move.endRow][move.endCol] = movedPiece;
-    newBoard[move.startRow][move.startCol] = EMPTY_SQUARE;
+// Runs the AI's search off the GUI thread. Progress and the final result are sent
+// back by signals, which Qt queues onto the GUI thread.
+class SearchThread : public QThread {
+    Q_OBJECT
 
-    // Remove captured pieces
-    for (const auto& captured : move.capturedPieces) {
-        newBoard[captured.first][captured.second] = EMPTY_SQUARE;
+public:
+    explicit SearchThread(QObject* parent = nullptr) : QThread(parent) {}
+
+    // Search the given position for White; must not be called while a search runs
+    void startSearch(const Bitboard& board, int maxDepth, int timeLimitMs, int threads) {
+        searchBoard = board;
+        searchDepth = maxDepth;
+        searchTimeMs = timeLimitMs;
+        searchThreads = threads;
+        cancelRequested.store(false);
+        start();
     }
 
-    // Promote to King if a piece reaches the opposite end
-    if (movedPiece == WHITE_PIECE && move.endRow == 0) {
-        newBoard[move.endRow][move.endCol] = WHITE_KING;
+    // Evaluation weights for the following searches; must not be called while a search runs
+    void setWeights(const EvalWeights& weights) {
+        searchWeights = weights;
     }
-    else if (movedPiece == BLACK_PIECE && move.endRow == 7) {
-        newBoard[move.endRow][move.endCol] = BLACK_KING;
-    }
-
-    return newBoard;
-}
-
-
-// The Alpha-Beta pruning algorithm function
-// alpha: Best value Maximizer (AI - White) can guarantee so far
-// beta: Best value Minimizer (Human - Black) can guarantee so far
-// depth: Current search depth
-// maxDepth: Maximum search depth
-int alphaBeta(CheckersBoard& board, int depth, int maxDepth, bool isMaximizingPlayer, int alpha, int beta) {
-    // Base case: If max depth is reached or no legal moves for the current player
-    char currentPlayer = isMaximizingPlayer ? WHITE : BLACK;
-    vector<Move> possibleMoves = generateLegalMoves(board, currentPlayer);
 
-    if (depth == maxDepth || possibleMoves.empty()) {
-        return evaluateBoard(board);
+    // Stop the running search early; it still reports the deepest completed iteration
+    void cancel() {
+        cancelRequested.store(true);
     }
 
-
-    if (isMaximizingPlayer) { // White's turn (AI)
-        int best = numeric_limits<int>::min();
-
-        for (const auto& move : possibleMoves) {
-            // Apply the move
-            CheckersBoard newBoard = applyMove(board, move);
-
-            // Recurse
-            int value = alphaBeta(newBoard, depth + 1, maxDepth, false, alpha, beta);
-
-            best = max(best, value);
-            alpha = max(alpha, best);
-
-            // Alpha Beta Pruning
-            if (beta <= alpha) {
-                break;
-            }
-        }
-        return best;
+signals:
+    void iterationCompleted(const SearchResult& progress);
+    void searchFinished(const SearchResult& result);
+
+protected:
+    void run() override {
+        SearchOptions options;
+        options.maxDepth = searchDepth;
+        options.timeLimitMs = searchTimeMs;
+        options.threads = searchThreads;
+        options.cancel = &cancelRequested;
+        options.onIteration = [this](const SearchResult& progress) { emit iterationCompleted(progress); };
+        options.weights = searchWeights;
+        SearchResult result = findBestMove(searchBoard, WHITE, options);
+        emit searchFinished(result);
     }
-    else { // Black's turn (Human)
-        int best = numeric_limits<int>::max();
-
-        for (const auto& move : possibleMoves) {
-            // Apply the move
-            CheckersBoard newBoard = applyMove(board, move);
-
-            // Recurse
-            int value = alphaBeta(newBoard, depth + 1, maxDepth, true, alpha, beta);
-
-            best = min(best, value);
-            beta = min(beta, best);
-
-            // Alpha Beta Pruning
-            if (beta <= alpha) {
-                break;
-            }
-        }
-        return best;
-    }
-}
-
-// Function to find the best move for the AI using Alpha-Beta
-Move findBestMove(CheckersBoard& board, int maxDepth) {
-    int bestVal = numeric_limits<int>::min();
-    Move bestMove = { -1, -1, -1, -1, false, {} }; // Indicate no valid move found yet
-
-    int alpha = numeric_limits<int>::min();
-    int beta = numeric_limits<int>::max();
-
-    vector<Move> possibleMoves = generateLegalMoves(board, WHITE); // AI is White
-
-    for (const auto& move : possibleMoves) {
-        // Apply the move
-        CheckersBoard newBoard = applyMove(board, move);
 
-        // Compute evaluation function for this move with Alpha-Beta
-        int moveVal = alphaBeta(newBoard, 0, maxDepth, false, alpha, beta); // After AI moves, it's Human's turn (minimizing)
-
-        // If the value of the current move is more than the best value, then update best
-        if (moveVal > bestVal) {
-            bestVal = moveVal;
-            bestMove = move;
-        }
-        // Update alpha for the top-level call (maximizing player's turn)
-        alpha = max(alpha, moveVal);
-    }
-    qDebug() << "Best AI move found:" << bestMove.startRow << bestMove.startCol << "to" << bestMove.endRow << bestMove.endCol << "Is Capture:" << bestMove.isCapture;
-    return bestMove;
-}
+private:
+    Bitboard searchBoard = {};
+    int searchDepth = DEFAULT_SEARCH_DEPTH;
+    int searchTimeMs = 0;
+    int searchThreads = 1;
+    EvalWeights searchWeights;
+    std::atomic<bool> cancelRequested{ false };
+};
 
 
 // --- Qt GUI Implementation ---
@@ -331,9 +95,17 @@ class CheckersWindow : public QMainWindow {
     Q_OBJECT // Add this macro
 
 public:
-    CheckersWindow(QWidget* parent = nullptr) : QMainWindow(parent) {
+    // searchDepth caps the iterative deepening; moveTimeMs <= 0 means no time limit.
+    // showStats adds a row with the per-depth statistics of the AI's last search.
+    // ponder lets the AI search the predicted reply while the human thinks.
+    // weights are the AI's evaluation weights, e.g. loaded from a checkers_tune file.
+    // gameLog, if set, gets the game's moves and the search behind the AI's moves.
+    CheckersWindow(int searchDepth = DEFAULT_SEARCH_DEPTH, int moveTimeMs = 0, int searchThreads = 1, bool showStats = false,
+                   bool ponder = false, const EvalWeights& weights = EvalWeights(), GameLogWriter* gameLog = nullptr,
+                   QWidget* parent = nullptr)
+        : QMainWindow(parent), gameLog(gameLog) {
         setWindowTitle("Simplified Checkers with Alpha-Beta");
-        setFixedSize(640, 700); // Adjust size for 8x8 board
+        setFixedSize(640, showStats ? 870 : 730); // Adjust size for 8x8 board, status, thinking and statistics rows
 
         QWidget* centralWidget = new QWidget(this);
         QGridLayout* gridLayout = new QGridLayout(centralWidget);
@@ -359,7 +131,7 @@ public:
                 boardButtons[i][j] = button;
 
                 // Connect button click to the handleButtonClick slot
-                connect(button, &QPushButton::clicked, this, [=]() {
+                connect(button, &QPushButton::clicked, this, [=, this]() {
                     handleSquareClick(i, j);
                     });
             }
@@ -371,32 +143,64 @@ public:
         statusLabel->setFont(QFont("Arial", 16));
         gridLayout->addWidget(statusLabel, 8, 0, 1, 8); // Span across all columns
 
+        // Live search information and the button that stops the AI early
+        thinkingLabel = new QLabel("", centralWidget);
+        thinkingLabel->setAlignment(Qt::AlignCenter);
+        gridLayout->addWidget(thinkingLabel, 9, 0, 1, 6);
+        stopButton = new QPushButton("Move Now", centralWidget);
+        stopButton->setEnabled(false);
+        gridLayout->addWidget(stopButton, 9, 6, 1, 2);
+
+        // Per-depth statistics of the last search, only with --stats
+        statsLabel = new QLabel("", centralWidget);
+        statsLabel->setFont(QFont("Monospace", 9));
+        statsLabel->setVisible(showStats);
+        gridLayout->addWidget(statsLabel, 10, 0, 1, 8);
+        statsEnabled = showStats;
+
+        searchThread = new SearchThread(this);
+        searchThread->setWeights(weights);
+        connect(stopButton, &QPushButton::clicked, searchThread, &SearchThread::cancel);
+        connect(searchThread, &SearchThread::iterationCompleted, this, &CheckersWindow::showSearchProgress);
+        connect(searchThread, &SearchThread::searchFinished, this, &CheckersWindow::playAIMove);
+
+        // Pondering has a search thread of its own; Move Now also ends a ponder hit that is still searching
+        ponderThread = new SearchThread(this);
+        ponderThread->setWeights(weights);
+        connect(stopButton, &QPushButton::clicked, ponderThread, &SearchThread::cancel);
+        connect(ponderThread, &SearchThread::iterationCompleted, this, &CheckersWindow::showPonderProgress);
+        connect(ponderThread, &SearchThread::searchFinished, this, &CheckersWindow::ponderFinished);
+        ponderEnabled = ponder;
+
         // Initialize game state
         gameBoard = initializeBoard();
         currentPlayer = WHITE; // AI (White) starts
         selectedSquare = { -1, -1 }; // No square selected initially
-        aiSearchDepth = 5; // Set a shallow search depth for simplicity/speed
+        aiSearchDepth = searchDepth;
+        aiMoveTimeMs = moveTimeMs;
+        aiThreads = searchThreads;
+        aiWeights = weights;
+        if (gameLog) gameLog->beginGame(toBitboard(gameBoard), WHITE);
 
         updateBoardUI(); // Update the UI to show the initial board
 
-        // Since AI starts, trigger its first move
+        // Since AI starts, trigger its first move; the search runs while the window opens
         if (currentPlayer == WHITE) {
             qDebug() << "AI's turn (White) - Making first move...";
-            QApplication::processEvents(); // Update UI before AI thinks
             makeAIMove();
-            updateBoardUI();
-            // Check game end after AI move, and only switch turn if game is not over
-            if (!checkGameEnd()) {
-                currentPlayer = BLACK;
-                statusLabel->setText("Black's turn (Human)");
-                qDebug() << "Switched to Black's turn.";
-            }
-            else {
-                qDebug() << "Game ended after AI's first move.";
-            }
         }
     }
 
+protected:
+    // A running search must finish before its thread object is destroyed
+    void closeEvent(QCloseEvent* event) override {
+        searchThread->cancel();
+        searchThread->wait();
+        stopPondering();
+        if (currentPlayer != EMPTY_SQUARE) logGameEnd(GAME_UNFINISHED);
+        event->accept();
+    }
+
 private slots:
     // Slot to handle square clicks
     void handleSquareClick(int row, int col) {
@@ -432,6 +236,17 @@ private slots:
                     playerMove.capturedPieces.push_back({ jumpedRow, jumpedCol });
                 }
 
+                // A man that is crowned ends its turn, even in the middle of a multi-jump
+                bool isCrowning = gameBoard[playerMove.startRow][playerMove.startCol] == BLACK_PIECE && playerMove.endRow == 7;
+
+                // The whole turn is logged as one move, from the first jump's square to the last one's
+                if (!humanMoveStarted) {
+                    humanTurnStart = toBitboard(gameBoard, BLACK);
+                    humanMoveFrom = squareIndex(playerMove.startRow, playerMove.startCol);
+                    humanMoveStarted = true;
+                }
+                humanMoveTo = squareIndex(playerMove.endRow, playerMove.endCol);
+
                 // Apply the player's move
                 gameBoard = applyMove(gameBoard, playerMove);
 
@@ -440,13 +255,14 @@ private slots:
 
                 // Check for game end after player move
                 if (checkGameEnd()) {
+                    stopPondering();
                     selectedSquare = { -1, -1 }; // Reset selection
                     return; // Game is over
                 }
 
                 // Simplified multi-jump check: If a capture was made, check if more captures are possible from the new position
                 // A full implementation would enforce mandatory multi-jumps.
-                if (playerMove.isCapture) {
+                if (playerMove.isCapture && !isCrowning) {
                     vector<Move> possibleNextCaptures = generateLegalMoves(gameBoard, BLACK);
                     bool canMultiJump = false;
                     for (const auto& nextMove : possibleNextCaptures) {
@@ -467,29 +283,13 @@ private slots:
 
 
                 // Switch to AI's turn if no multi-jump
+                logHumanMove();
                 currentPlayer = WHITE;
                 statusLabel->setText("White's turn (AI)");
                 qDebug() << "Switched to White's turn.";
 
-                // Trigger AI's move
-                QApplication::processEvents(); // Update UI before AI thinks
+                // Trigger AI's move; playAIMove hands the turn back when the search is done
                 makeAIMove();
-                updateBoardUI();
-
-                // Check for game end after AI move
-                checkGameEnd();
-
-                // Switch back to player's turn if game is not over and turn is still AI's
-                if (currentPlayer == WHITE) {
-                    currentPlayer = BLACK;
-                    statusLabel->setText("Black's turn (Human)");
-                    qDebug() << "Switched back to Black's turn.";
-                }
-                else {
-                    qDebug() << "Game ended after AI's move.";
-                }
-
-
             }
             else {
                 // Invalid move
@@ -521,43 +321,202 @@ private slots:
         }
     }
 
-    // Function to make the AI's move using Alpha-Beta
+    // Function to start the AI's Alpha-Beta search on the search thread; the GUI stays responsive
     void makeAIMove() {
         statusLabel->setText("White's turn (AI) - Thinking...");
-        QApplication::processEvents(); // Update status label
+        thinkingLabel->setText("");
+        stopButton->setEnabled(true);
+        Bitboard board = toBitboard(gameBoard);
+        if (pondering && resolvePonder(board)) return;
         qDebug() << "AI thinking...";
+        searchThread->wait(); // The last search has reported; let its thread exit before restarting it
+        searchThread->startSearch(board, aiSearchDepth, aiMoveTimeMs, aiThreads);
+    }
 
-        Move aiMove = findBestMove(gameBoard, aiSearchDepth);
+    // The human has moved while the AI pondered. On a hit the ponder search becomes the
+    // AI's search: its result is played at once, or when it finishes (with --movetime,
+    // when the budget counted from the start of pondering runs out). On a miss the
+    // ponder is dropped and false is returned; the table it filled still helps.
+    bool resolvePonder(const Bitboard& board) {
+        ++ponderMoves;
+        if (board.white != ponderBoard.white || board.black != ponderBoard.black || board.kings != ponderBoard.kings) {
+            qDebug() << "Ponder miss after" << ponderClock.elapsed() << "ms";
+            stopPondering();
+            return false;
+        }
+        ++ponderHits;
+        ponderHit = true;
+        if (ponderDone) {
+            ponderSavedMs += (qint64)(ponderResult.seconds * 1000.0);
+            qDebug() << "Ponder hit: search already finished";
+            playAIMove(ponderResult);
+            return true;
+        }
+        qint64 pondered = ponderClock.elapsed();
+        ponderSavedMs += pondered;
+        qDebug() << "Ponder hit after" << pondered << "ms";
+        if (aiMoveTimeMs > 0) {
+            int generation = ponderGeneration;
+            qint64 remaining = max<qint64>(0, aiMoveTimeMs - pondered);
+            QTimer::singleShot((int)remaining, this, [this, generation]() {
+                if (pondering && generation == ponderGeneration) ponderThread->cancel();
+            });
+        }
+        return true;
+    }
 
-        if (aiMove.startRow != -1) { // Check if a valid move was found
-            // Apply the AI's move
-            gameBoard = applyMove(gameBoard, aiMove);
-            qDebug() << "AI made move:" << aiMove.startRow << aiMove.startCol << "to" << aiMove.endRow << aiMove.endCol << "Is Capture:" << aiMove.isCapture;
-
-            // Simplified multi-jump check for AI
-            if (aiMove.isCapture) {
-                vector<Move> possibleNextCaptures = generateLegalMoves(gameBoard, WHITE);
-                bool canMultiJump = false;
-                for (const auto& nextMove : possibleNextCaptures) {
-                    if (nextMove.isCapture && nextMove.startRow == aiMove.endRow && nextMove.startCol == aiMove.endCol) {
-                        canMultiJump = true;
-                        break;
-                    }
-                }
-                if (canMultiJump) {
-                    statusLabel->setText("White's turn (AI) - Multi-jump!");
-                    QApplication::processEvents(); // Update status label
-                    makeAIMove(); // Trigger another AI move for multi-jump
-                    return; // AI stays in turn for multi-jump
+    // Guess the human's reply (the table's move for the position, else a shallow
+    // search) and start searching the position after it
+    void startPondering() {
+        if (!ponderEnabled || currentPlayer != BLACK) return;
+        Bitboard board = toBitboard(gameBoard, BLACK);
+        vector<BitMove> replies = generateLegalMoves(board, BLACK);
+        const BitMove* predicted = nullptr;
+        TTEntry entry;
+        if (transpositionTable.probe(board.hash, entry) && entry.hasMove) {
+            for (const BitMove& reply : replies) {
+                if (reply.from == entry.bestMove.from && reply.to == entry.bestMove.to) {
+                    predicted = &reply;
+                    break;
                 }
             }
+        }
+        BitMove searched;
+        if (!predicted) {
+            SearchOptions options;
+            options.maxDepth = PONDER_PREDICTION_DEPTH;
+            options.weights = aiWeights;
+            options.useBook = false; // Only a guess; the book would count it as an AI move
+            searched = findBestMove(board, BLACK, options).bestMove;
+            predicted = &searched;
+        }
+        ponderBoard = applyMove(board, *predicted);
+        if (generateLegalMoves(ponderBoard, WHITE).empty()) return;
+
+        // With a time budget the ponder deepens until the human moves
+        int depth = aiMoveTimeMs > 0 ? MAX_SEARCH_DEPTH : aiSearchDepth;
+        pondering = true;
+        ponderDone = false;
+        ponderHit = false;
+        ++ponderGeneration;
+        ponderMove = QString::fromStdString(moveToString(*predicted));
+        ponderClock.start();
+        qDebug() << "Pondering on" << ponderMove;
+        ponderThread->wait(); // The last ponder has reported; let its thread exit before restarting it
+        ponderThread->startSearch(ponderBoard, depth, 0, aiThreads);
+    }
+
+    // Cancel the ponder search (if any) and wait for it
+    void stopPondering() {
+        if (!pondering) return;
+        pondering = false;
+        ponderThread->cancel();
+        ponderThread->wait();
+    }
 
+    // The ponder search ended: play it after a hit, otherwise keep it for one
+    void ponderFinished(const SearchResult& result) {
+        if (!pondering) return; // Cancelled by a miss
+        if (ponderHit) {
+            playAIMove(result); // Clears pondering after counting the move as a ponder hit
+            return;
+        }
+        ponderResult = result;
+        ponderDone = true;
+    }
+
+    // Progress of the ponder search: the AI's own search after a hit, otherwise shown as pondering
+    void showPonderProgress(const SearchResult& progress) {
+        if (!pondering) return;
+        if (ponderHit) {
+            showSearchProgress(progress);
+            return;
+        }
+        thinkingLabel->setText(QString("Pondering %1  Depth %2  Score %3")
+                                   .arg(ponderMove)
+                                   .arg(progress.depth)
+                                   .arg(progress.score));
+    }
+
+    // Show the deepest completed iteration while the AI is thinking
+    void showSearchProgress(const SearchResult& progress) {
+        double nps = progress.nodes / max(progress.seconds, 1e-9);
+        thinkingLabel->setText(QString("Depth %1  Score %2  %3 knodes/s  Best %4")
+                                   .arg(progress.depth)
+                                   .arg(progress.score)
+                                   .arg(nps / 1000.0, 0, 'f', 0)
+                                   .arg(QString::fromStdString(moveToString(progress.bestMove))));
+    }
+
+    // Fill the statistics row with the deepest iterations of a finished search and log them as JSON
+    void showSearchStats(const SearchResult& result) {
+        const size_t shownIterations = 6;
+        QString text = QString("%1 %2 %3 %4 %5 %6 %7").arg("depth", 5).arg("knodes", 9).arg("ebf", 6)
+                           .arg("1st cut", 8).arg("tt hit", 7).arg("research", 9).arg("ms", 8);
+        size_t first = result.iterations.size() > shownIterations ? result.iterations.size() - shownIterations : 0;
+        for (size_t i = first; i < result.iterations.size(); ++i) {
+            const IterationStats& iteration = result.iterations[i];
+            double firstMoveCutoffs = iteration.cutoffs ? 100.0 * iteration.firstMoveCutoffs / iteration.cutoffs : 0.0;
+            double ttHits = iteration.ttProbes ? 100.0 * iteration.ttHits / iteration.ttProbes : 0.0;
+            text += QString("\n%1 %2 %3 %4% %5% %6 %7").arg(iteration.depth, 5).arg(iteration.nodes / 1000.0, 9, 'f', 1)
+                        .arg(effectiveBranchingFactor(result, i), 6, 'f', 2).arg(firstMoveCutoffs, 7, 'f', 1)
+                        .arg(ttHits, 6, 'f', 1).arg((qulonglong)iteration.researches, 9).arg(iteration.seconds * 1000.0, 8, 'f', 1);
+        }
+        statsLabel->setText(text);
+        qDebug().noquote() << "Search stats:" << QString::fromStdString(searchStatsJson(result));
+    }
+
+    // Function to play the move found by the search and hand the turn back to the human
+    void playAIMove(const SearchResult& result) {
+        stopButton->setEnabled(false);
+        bool fromPonder = pondering && ponderHit;
+        pondering = false;
+        if (currentPlayer != WHITE) return; // Game was ended while the AI was thinking
+
+        if (result.hasMove) {
+            // Apply the AI's move; a capture move already contains the whole multi-jump
+            Move aiMove = toMove(result.bestMove);
+            gameBoard = applyMove(gameBoard, aiMove);
+            if (gameLog) gameLog->logMove(loggedMove(result));
+            qDebug() << "AI made move:" << aiMove.startRow << aiMove.startCol << "to" << aiMove.endRow << aiMove.endCol << "Is Capture:" << aiMove.isCapture
+                     << "Captured:" << aiMove.capturedPieces.size()
+                     << "depth" << result.depth << "nodes" << result.nodes << "time" << result.seconds << "s";
+            if (statsEnabled && !result.fromBook) showSearchStats(result);
+            // Counted here rather than by the book's probes, which ponder searches also make
+            ++aiMovesPlayed;
+            if (result.fromBook) {
+                ++bookMovesPlayed;
+                thinkingLabel->setText(QString("Book move %1  (book hits: %2 of %3 AI moves)")
+                                           .arg(QString::fromStdString(moveToString(result.bestMove)))
+                                           .arg(bookMovesPlayed)
+                                           .arg(aiMovesPlayed));
+            }
+            else if (fromPonder) {
+                thinkingLabel->setText(QString("Ponder hit %1  (hits: %2 of %3 AI moves, %4 s saved)")
+                                           .arg(QString::fromStdString(moveToString(result.bestMove)))
+                                           .arg(ponderHits)
+                                           .arg(ponderMoves)
+                                           .arg(ponderSavedMs / 1000.0, 0, 'f', 1));
+            }
         }
         else {
             // No valid move found for AI (shouldn't happen in a normal game unless game over)
             statusLabel->setText("AI has no legal moves.");
             qDebug() << "AI found no legal moves.";
         }
+        updateBoardUI();
+
+        // Check game end after AI move, and only switch turn if game is not over
+        if (!checkGameEnd()) {
+            currentPlayer = BLACK;
+            statusLabel->setText("Black's turn (Human)");
+            qDebug() << "Switched to Black's turn.";
+            humanClock.start();
+            startPondering();
+        }
+        else {
+            qDebug() << "Game ended after AI's move.";
+        }
     }
 
     // Function to check if the game has ended (simplified: checks if a player has no pieces or no legal moves)
@@ -573,6 +532,7 @@ private slots:
         }
 
         if (!whitePieceExists) {
+            logGameEnd(-1);
             statusLabel->setText("Black Wins!");
             disableAllButtons();
             QMessageBox::information(this, "Game Over", "Black Wins!");
@@ -581,6 +541,7 @@ private slots:
             return true;
         }
         else if (!blackPieceExists) {
+            logGameEnd(1);
             statusLabel->setText("White Wins!");
             disableAllButtons();
             QMessageBox::information(this, "Game Over", "White Wins!");
@@ -591,6 +552,7 @@ private slots:
 
         // Check if the current player has any legal moves
         if (generateLegalMoves(gameBoard, currentPlayer).empty()) {
+            logGameEnd(currentPlayer == WHITE ? -1 : 1);
             if (currentPlayer == WHITE) {
                 statusLabel->setText("Black Wins (White has no moves)!");
                 QMessageBox::information(this, "Game Over", "Black Wins (White has no moves)!");
@@ -609,6 +571,25 @@ private slots:
         return false;
     }
 
+    // Log the human's turn as one move; the GUI plays a multi-jump one click at a time
+    void logHumanMove() {
+        if (!humanMoveStarted) return;
+        humanMoveStarted = false;
+        if (!gameLog) return;
+        LoggedMove move;
+        uint32_t captured = humanTurnStart.white & ~toBitboard(gameBoard).white;
+        move.move = { (uint8_t)humanMoveFrom, (uint8_t)humanMoveTo, captured };
+        move.source = MOVE_BY_HUMAN;
+        move.timeMs = (uint32_t)humanClock.elapsed();
+        gameLog->logMove(move);
+    }
+
+    // Close the game in the log with its result for White (or GAME_UNFINISHED)
+    void logGameEnd(int result) {
+        logHumanMove();
+        if (gameLog) gameLog->endGame(result);
+    }
+
     // Function to disable all buttons after the game ends
     void disableAllButtons() {
         for (int i = 0; i < 8; ++i) {
@@ -625,14 +606,238 @@ private:
     char currentPlayer; // 'W' or 'B'
     Square selectedSquare; // Stores the coordinates of the selected piece
     int aiSearchDepth; // Depth for Alpha-Beta search
+    int aiMoveTimeMs; // Time budget per AI move in milliseconds (0 = unlimited)
+    int aiThreads; // Number of search threads
+    EvalWeights aiWeights; // Evaluation weights of the AI searches (--eval)
     QLabel* statusLabel; // Label to display game status
+    QLabel* thinkingLabel; // Depth, score and speed of the running AI search
+    QPushButton* stopButton; // Stops the AI search and plays its best move so far
+    QLabel* statsLabel; // Per-depth statistics of the last AI search (--stats)
+    bool statsEnabled; // Whether statsLabel is shown and filled
+    SearchThread* searchThread; // Runs the AI search off the GUI thread
+    int aiMovesPlayed = 0; // AI moves played, for the book hit rate
+    int bookMovesPlayed = 0; // Of those, moves from the opening book
+
+    // Game log (--log): the human's turn is collected until it ends, then logged as one move
+    GameLogWriter* gameLog;
+    bool humanMoveStarted = false; // The human has made the first jump or step of the turn
+    Bitboard humanTurnStart = {};  // Position before it
+    int humanMoveFrom = 0;
+    int humanMoveTo = 0;
+    QElapsedTimer humanClock;      // Started when the human's turn begins
+
+    // Pondering (--ponder): searching the predicted human reply during the human's turn
+    bool ponderEnabled;
+    SearchThread* ponderThread;
+    bool pondering = false;      // A ponder search runs or has finished, and is not yet used or dropped
+    bool ponderDone = false;     // It finished before the human moved; the result is in ponderResult
+    bool ponderHit = false;      // The human played the predicted reply; the ponder is the AI's search now
+    int ponderGeneration = 0;    // Tells a --movetime timer whether its ponder is still the current one
+    Bitboard ponderBoard = {};   // Position after the predicted reply
+    QString ponderMove;          // The predicted reply
+    SearchResult ponderResult;
+    QElapsedTimer ponderClock;   // Started with the ponder search
+    int ponderHits = 0;
+    int ponderMoves = 0;         // AI moves that had a ponder search to check
+    qint64 ponderSavedMs = 0;    // Search time already spent when the hits happened
+};
+
+
+// --- Game Replay ---
+
+// Steps through a logged game (--replay): the board after each move, with the search
+// that chose the move. The buttons or the arrow keys move through the game.
+class ReplayWindow : public QMainWindow {
+    Q_OBJECT
+
+public:
+    ReplayWindow(const LoggedGame& game, const vector<Bitboard>& positions, QWidget* parent = nullptr)
+        : QMainWindow(parent), game(game), positions(positions) {
+        setWindowTitle("Simplified Checkers with Alpha-Beta - Replay");
+        setFixedSize(640, 760);
+
+        QWidget* centralWidget = new QWidget(this);
+        QGridLayout* gridLayout = new QGridLayout(centralWidget);
+        centralWidget->setLayout(gridLayout);
+        setCentralWidget(centralWidget);
+
+        for (int i = 0; i < 8; ++i) {
+            for (int j = 0; j < 8; ++j) {
+                QPushButton* button = new QPushButton("", centralWidget);
+                button->setFixedSize(80, 80);
+                button->setFont(QFont("Arial", 30));
+                gridLayout->addWidget(button, i, j);
+                boardButtons[i][j] = button;
+            }
+        }
+
+        moveLabel = new QLabel("", centralWidget);
+        moveLabel->setAlignment(Qt::AlignCenter);
+        moveLabel->setFont(QFont("Arial", 12));
+        gridLayout->addWidget(moveLabel, 8, 0, 1, 8);
+
+        const char* names[4] = { "|<", "<", ">", ">|" };
+        for (int k = 0; k < 4; ++k) {
+            QPushButton* button = new QPushButton(names[k], centralWidget);
+            gridLayout->addWidget(button, 9, k * 2, 1, 2);
+            connect(button, &QPushButton::clicked, this, [=, this]() {
+                int target[4] = { 0, ply - 1, ply + 1, (int)positions.size() - 1 };
+                showPly(target[k]);
+                });
+        }
+        showPly(0);
+    }
+
+protected:
+    void keyPressEvent(QKeyEvent* event) override {
+        switch (event->key()) {
+        case Qt::Key_Left: showPly(ply - 1); break;
+        case Qt::Key_Right: showPly(ply + 1); break;
+        case Qt::Key_Home: showPly(0); break;
+        case Qt::Key_End: showPly((int)positions.size() - 1); break;
+        default: QMainWindow::keyPressEvent(event);
+        }
+    }
+
+private:
+    // Show the position after `shown` moves, marking the square the last move ended on
+    void showPly(int shown) {
+        ply = max(0, min(shown, (int)positions.size() - 1));
+        CheckersBoard board = toCheckersBoard(positions[ply]);
+        int lastTo = ply > 0 ? game.moves[ply - 1].move.to : -1;
+        for (int i = 0; i < 8; ++i) {
+            for (int j = 0; j < 8; ++j) {
+                bool dark = (i + j) % 2 != 0;
+                QString style = dark ? "background-color: #B58863; color: white;" : "background-color: #F0D9B5;";
+                if (dark && squareIndex(i, j) == lastTo) style += "border: 2px solid blue;";
+                boardButtons[i][j]->setStyleSheet(style);
+                boardButtons[i][j]->setText(dark ? QString(board[i][j]) : QString(""));
+            }
+        }
+
+        QString text = QString("Ply %1 of %2").arg(ply).arg((int)game.moves.size());
+        if (ply > 0) {
+            const LoggedMove& move = game.moves[ply - 1];
+            bool whiteMoved = (ply % 2 == 1) == (game.startSide == WHITE);
+            text += QString("  %1 played %2").arg(whiteMoved ? "White" : "Black")
+                        .arg(QString::fromStdString(moveToString(move.move)));
+            if (move.source == MOVE_SEARCHED) {
+                text += QString("  depth %1  score %2  %3 knodes  %4 ms").arg(move.depth).arg(move.score)
+                            .arg(move.nodes / 1000.0, 0, 'f', 1).arg((qulonglong)move.timeMs);
+            }
+            else {
+                text += QString("  (%1, %2 ms)").arg(move.source == MOVE_FROM_BOOK ? "book" : "human").arg((qulonglong)move.timeMs);
+            }
+        }
+        if (ply == (int)game.moves.size()) {
+            const char* result = game.result == GAME_UNFINISHED ? "unfinished" : game.result > 0 ? "White won"
+                               : game.result < 0 ? "Black won" : "draw";
+            text += QString("\nEnd of game: %1").arg(result);
+        }
+        moveLabel->setText(text);
+    }
+
+    QPushButton* boardButtons[8][8];
+    QLabel* moveLabel; // The move that led to the shown position and its search
+    LoggedGame game;
+    vector<Bitboard> positions; // positions[ply] is the board after `ply` moves
+    int ply = 0;
 };
 
 #include "main.moc" // Include the generated moc file
 
 int main(int argc, char* argv[]) {
     QApplication a(argc, argv);
-    CheckersWindow w;
+    qRegisterMetaType<SearchResult>("SearchResult"); // Passed between threads by queued signals
+
+    // Command line options
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Simplified Checkers with Alpha-Beta");
+    parser.addHelpOption();
+    QCommandLineOption hashOption("hash", "Transposition table size in megabytes.", "MB", QString::number(DEFAULT_HASH_MB));
+    parser.addOption(hashOption);
+    QCommandLineOption depthOption("depth", "Maximum AI search depth.", "plies");
+    parser.addOption(depthOption);
+    QCommandLineOption moveTimeOption("movetime", "AI time budget per move in milliseconds.", "ms");
+    parser.addOption(moveTimeOption);
+    QCommandLineOption threadsOption("threads", "Number of AI search threads.", "count", "1");
+    parser.addOption(threadsOption);
+    QCommandLineOption bookOption("book", "Opening book built by checkers_book.", "file");
+    parser.addOption(bookOption);
+    QCommandLineOption tablebasesOption("tablebases", "Directory of endgame tables built by checkers_tbgen.", "dir");
+    parser.addOption(tablebasesOption);
+    QCommandLineOption evalOption("eval", "Evaluation weights written by checkers_tune.", "file");
+    parser.addOption(evalOption);
+    QCommandLineOption ponderOption("ponder", "Let the AI search the predicted reply while you think.");
+    parser.addOption(ponderOption);
+    QCommandLineOption statsOption("stats", "Show per-depth search statistics after every AI move.");
+    parser.addOption(statsOption);
+    QCommandLineOption logOption("log", "Append the game, with the search behind every AI move, to this game log.", "file");
+    parser.addOption(logOption);
+    QCommandLineOption replayOption("replay", "Step through a game from this game log instead of playing.", "file");
+    parser.addOption(replayOption);
+    QCommandLineOption gameOption("game", "Offset of the game to replay, as listed by checkers_games (default: the last game).", "offset");
+    parser.addOption(gameOption);
+    parser.process(a);
+
+    if (parser.isSet(replayOption)) {
+        GameLogReader reader;
+        LoggedGame game;
+        bool found = reader.open(parser.value(replayOption).toStdString());
+        if (found && parser.isSet(gameOption)) {
+            uint64_t offset = parser.value(gameOption).toULongLong();
+            found = reader.seek(offset) && reader.next(game) && game.offset == offset;
+        }
+        else if (found) {
+            found = false;
+            while (reader.next(game)) found = true; // Streams the log; only the last game is kept
+        }
+        vector<Bitboard> positions;
+        if (!found || !replayLoggedGame(game, positions)) {
+            QMessageBox::critical(nullptr, "Replay", "No game to replay: the log cannot be read, has no game at that offset, or is damaged.");
+            return 1;
+        }
+        ReplayWindow replay(game, positions);
+        replay.show();
+        return a.exec();
+    }
+
+    // With only a time budget the search deepens as far as the clock allows
+    int moveTimeMs = parser.isSet(moveTimeOption) ? parser.value(moveTimeOption).toInt() : 0;
+    int searchDepth = DEFAULT_SEARCH_DEPTH;
+    if (parser.isSet(depthOption)) searchDepth = max(1, parser.value(depthOption).toInt());
+    else if (moveTimeMs > 0) searchDepth = MAX_SEARCH_DEPTH;
+
+    bool validHash = false;
+    size_t hashMB = parser.value(hashOption).toULongLong(&validHash);
+    transpositionTable.resize(validHash ? hashMB : DEFAULT_HASH_MB);
+    qDebug() << "Transposition table:" << transpositionTable.sizeBytes() / (1024 * 1024) << "MB";
+
+    int threads = clamp(parser.value(threadsOption).toInt(), 1, MAX_SEARCH_THREADS);
+
+    if (parser.isSet(bookOption)) {
+        bool loaded = openingBook.load(parser.value(bookOption).toStdString());
+        qDebug() << "Opening book:" << (loaded ? openingBook.size() : 0) << "positions";
+    }
+
+    if (parser.isSet(tablebasesOption)) {
+        int tables = tablebases.load(parser.value(tablebasesOption).toStdString());
+        qDebug() << "Endgame tables:" << tables << "up to" << tablebases.maxPieces() << "pieces";
+    }
+
+    EvalWeights weights;
+    if (parser.isSet(evalOption)) {
+        bool loaded = loadEvalWeights(parser.value(evalOption).toStdString(), weights);
+        qDebug() << "Evaluation weights:" << (loaded ? "loaded" : "not readable, using the defaults");
+    }
+
+    GameLogWriter gameLog;
+    if (parser.isSet(logOption) && !gameLog.open(parser.value(logOption).toStdString())) {
+        qDebug() << "Game log: cannot open" << parser.value(logOption) << "- the game is not logged";
+    }
+
+    CheckersWindow w(searchDepth, moveTimeMs, threads, parser.isSet(statsOption), parser.isSet(ponderOption), weights,
+                     gameLog.isOpen() ? &gameLog : nullptr);
     w.show();
     return a.exec();
 }